@@ -0,0 +1,117 @@
+// ImGui - FormatScalar() test (no window, no GPU)
+// FormatScalar() formats the common numeric formats without vsnprintf. This compares its output with ImFormatString() (vsnprintf) on random values
+// and on the values around every power of ten, where the digits count and the choice of fixed/scientific notation of "%g" change.
+// Returns 1 on any difference.
+
+#include <imgui.h>
+#include "imgui_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <float.h>
+
+static const char* FloatFormats[] = { "%.0f", "%.1f", "%.2f", "%.3f", "%.4f", "%.6f", "%.9f", "%f", "%g", "%.0g", "%.1g", "%.3g", "%.6g", "%.7g", "x=%.3f units", "%.0f%%", "100%% %g%%", "%5.2f", "%e", "%.10f", "%%", "abc" };
+static const char* IntFormats[] = { "%d", "%i", "v: %d!", "%5d", "%08X", "%.3d" };
+
+static int g_Checked = 0;
+static int g_Errors = 0;
+
+static void CheckFloat(float v)
+{
+    char a[128], b[128];
+    for (int n = 0; n < IM_ARRAYSIZE(FloatFormats); n++)
+    {
+        const int len_a = ImGui::FormatScalar(a, IM_ARRAYSIZE(a), FloatFormats[n], v);
+        const int len_b = ImFormatString(b, IM_ARRAYSIZE(b), FloatFormats[n], v);
+        g_Checked++;
+        if (len_a != len_b || strcmp(a, b) != 0)
+            if (g_Errors++ < 20)
+                printf("Error: format \"%s\", value %.9g (%a): \"%s\" instead of \"%s\"\n", FloatFormats[n], v, v, a, b);
+    }
+}
+
+static void CheckInt(int v)
+{
+    char a[128], b[128];
+    for (int n = 0; n < IM_ARRAYSIZE(IntFormats); n++)
+    {
+        const int len_a = ImGui::FormatScalar(a, IM_ARRAYSIZE(a), IntFormats[n], v);
+        const int len_b = ImFormatString(b, IM_ARRAYSIZE(b), IntFormats[n], v);
+        g_Checked++;
+        if (len_a != len_b || strcmp(a, b) != 0)
+            if (g_Errors++ < 20)
+                printf("Error: format \"%s\", value %d: \"%s\" instead of \"%s\"\n", IntFormats[n], v, a, b);
+    }
+}
+
+static unsigned int g_RandomState = 12345;
+static unsigned int Random()
+{
+    g_RandomState ^= g_RandomState << 13;
+    g_RandomState ^= g_RandomState >> 17;
+    g_RandomState ^= g_RandomState << 5;
+    return g_RandomState;
+}
+
+int main(int, char**)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsAlpha8(&tex_pixels, &tex_w, &tex_h);
+    ImGui::NewFrame();
+
+    // Powers of ten and their neighbor floats, positive and negative: 1e-4f is 9.99999975e-05, below the decimal value
+    for (int exponent = -12; exponent <= 12; exponent++)
+    {
+        const float p = (float)pow(10.0, exponent);
+        const float values[] = { p, nextafterf(p, 0.0f), nextafterf(p, FLT_MAX), p * 0.5f, p * 0.95f, p * 0.9999995f, p * 0.99999995f };
+        for (int n = 0; n < IM_ARRAYSIZE(values); n++)
+        {
+            CheckFloat(values[n]);
+            CheckFloat(-values[n]);
+        }
+    }
+
+    // Special values
+    const float specials[] = { 0.0f, -0.0f, FLT_MIN, FLT_MAX, 1e9f, nextafterf(1e9f, 0.0f), 0.5f, 1.5f, 2.5f, 0.125f, 0.0625f, 0.05f, 0.15f, 999999.5f, 9999999.0f, (float)HUGE_VAL, (float)-HUGE_VAL, sqrtf(-1.0f) };
+    for (int n = 0; n < IM_ARRAYSIZE(specials); n++)
+        CheckFloat(specials[n]);
+    const int int_specials[] = { 0, -1, 1, INT_MIN, INT_MAX, 999, 1000, -1000 };
+    for (int n = 0; n < IM_ARRAYSIZE(int_specials); n++)
+        CheckInt(int_specials[n]);
+
+    // Random values: any bit pattern, decimals, exact ties, any exponent
+    for (int i = 0; i < 200000; i++)
+    {
+        float v;
+        switch (i % 5)
+        {
+        case 0: { unsigned int bits = Random(); memcpy(&v, &bits, sizeof(v)); break; }
+        case 1: v = (float)((int)(Random() % 2000001) - 1000000) / 1000.0f; break;
+        case 2: v = (float)((int)(Random() % 20001) - 10000) * 0.125f; break;
+        case 3: v = ldexpf((float)(Random() % 16777216), (int)(Random() % 60) - 50) * ((Random() & 1) ? -1.0f : 1.0f); break;
+        default: v = (float)((int)(Random() % 2001) - 1000) * 0.0005f; break;
+        }
+        CheckFloat(v);
+        CheckInt((int)Random());
+    }
+
+    // Truncation to a small buffer
+    char a[8], b[8];
+    ImGui::FormatScalar(a, 5, "x=%.3f", 12.5f);
+    ImFormatString(b, 5, "x=%.3f", 12.5f);
+    g_Checked++;
+    if (strcmp(a, b) != 0)
+        if (g_Errors++ < 20)
+            printf("Error: truncated \"%s\" instead of \"%s\"\n", a, b);
+
+    ImGui::Render();
+    ImGui::Shutdown();
+
+    printf("%d checked, %d errors\n", g_Checked, g_Errors);
+    return g_Errors ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+// ImGui - null/dummy example application (no window, no GPU)
+// This runs a few frames of the demo and validates the draw data on the CPU instead of rendering it.
+// It checks that ImDrawData::VtxArena/IdxArena (io.DrawDataUseArenas) hold the same data as the individual draw lists, at the recorded offsets.
+
+#include <imgui.h>
+#include <stdio.h>
+#include <string.h>
+
+static int g_Errors = 0;
+
+static void Check(bool cond, const char* what, int list_n)
+{
+    if (cond)
+        return;
+    if (g_Errors++ < 10)
+        fprintf(stderr, "Error: %s (draw list %d)\n", what, list_n);
+}
+
+// Plays the role of a renderer: instead of uploading the buffers and drawing, compare the arenas to each ImDrawList
+static void NullRenderDrawLists(ImDrawData* draw_data)
+{
+    Check(draw_data->VtxArena != NULL && draw_data->IdxArena != NULL && draw_data->VtxOffsets != NULL && draw_data->IdxOffsets != NULL, "missing arenas", -1);
+    if (g_Errors)
+        return;
+
+    int vtx_offset = 0, idx_offset = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        Check(draw_data->VtxOffsets[n] == vtx_offset, "vertex offset doesn't follow the previous list", n);
+        Check(draw_data->IdxOffsets[n] == idx_offset, "index offset doesn't follow the previous list", n);
+
+        // Vertices are copied as is
+        Check(memcmp(draw_data->VtxArena + draw_data->VtxOffsets[n], cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert)) == 0, "vertices differ", n);
+
+        // Indices are IdxSpans (io.DrawListsUseIdxSpans) then IdxBuffer, relative to the first vertex of the list
+        const ImDrawIdx* idx_arena = draw_data->IdxArena + draw_data->IdxOffsets[n];
+        for (int span_n = 0; span_n < cmd_list->IdxSpans.Size; span_n++)
+        {
+            const ImDrawIdxSpan& span = cmd_list->IdxSpans[span_n];
+            Check(memcmp(idx_arena, span.IdxData, span.IdxCount * sizeof(ImDrawIdx)) == 0, "indices differ (span)", n);
+            idx_arena += span.IdxCount;
+        }
+        Check(memcmp(idx_arena, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx)) == 0, "indices differ", n);
+
+        // Each command must reference vertices of its own list, as a renderer would draw them with VtxOffsets[n] as base vertex
+        unsigned int elem_count = 0;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            const ImDrawIdx* idx = draw_data->IdxArena + draw_data->IdxOffsets[n] + elem_count;
+            for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+                Check(idx[i] < (unsigned int)cmd_list->VtxBuffer.Size, "index out of the list vertices", n);
+            elem_count += pcmd->ElemCount;
+        }
+        Check((int)elem_count == cmd_list->GetIdxCount(), "commands don't cover the list indices", n);
+
+        vtx_offset += cmd_list->VtxBuffer.Size;
+        idx_offset += cmd_list->GetIdxCount();
+    }
+    Check(vtx_offset == draw_data->TotalVtxCount, "TotalVtxCount mismatch", -1);
+    Check(idx_offset == draw_data->TotalIdxCount, "TotalIdxCount mismatch", -1);
+}
+
+int main(int, char**)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.IniFilename = NULL;
+    io.RenderDrawListsFn = NullRenderDrawLists;
+    io.DrawDataUseArenas = true;
+    io.DrawListsUseIdxSpans = true;
+    io.MouseDrawCursor = true;          // Also exercise the overlay draw list
+
+    // Build the font atlas, we don't need to upload it anywhere
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    bool show_test_window = true;
+    for (int frame = 0; frame < 120; frame++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        io.MousePos = ImVec2(100.0f + frame * 4.0f, 100.0f + frame * 2.0f);
+        io.MouseDown[0] = (frame % 20) < 10;
+        ImGui::NewFrame();
+
+        ImGui::ShowTestWindow(&show_test_window);
+        ImGui::ShowMetricsWindow();
+
+        ImGui::SetNextWindowPos(ImVec2(700, 400), ImGuiSetCond_FirstUseEver);
+        ImGui::Begin("Columns");
+        ImGui::Columns(4, "columns");
+        for (int i = 0; i < 40; i++)
+        {
+            ImGui::Text("Item %d", i);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::End();
+
+        ImGui::Render();
+    }
+    ImGui::Shutdown();
+
+    if (g_Errors)
+    {
+        printf("%d errors\n", g_Errors);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -59,6 +59,19 @@ void ImGui_ImplGlfw_RenderDrawLists(ImDrawData* draw_data)
     glEnable(GL_TEXTURE_2D);
     //glUseProgram(0); // You may want this if using this code in an OpenGL 3+ context
 
+    // Upload glyphs added to the font atlas since last frame (only with io.Fonts->DynamicGlyphs)
+    int dirty_x, dirty_y, dirty_w, dirty_h;
+    if (io.Fonts->GetTexDataDirtyRect(&dirty_x, &dirty_y, &dirty_w, &dirty_h))
+    {
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, dirty_x, dirty_y, dirty_w, dirty_h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (dirty_y * width + dirty_x) * 4);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
     // Setup viewport, orthographic projection matrix
     glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
     glMatrixMode(GL_PROJECTION);
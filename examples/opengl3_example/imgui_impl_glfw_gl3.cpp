@@ -26,7 +26,7 @@ static bool         g_MousePressed[3] = { false, false, false };
 static float        g_MouseWheel = 0.0f;
 static GLuint       g_FontTexture = 0;
 static int          g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
-static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
+static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0, g_AttribLocationUVScale = 0, g_AttribLocationDistanceField = 0;
 static int          g_AttribLocationPosition = 0, g_AttribLocationUV = 0, g_AttribLocationColor = 0;
 static unsigned int g_VboHandle = 0, g_VaoHandle = 0, g_ElementsHandle = 0;
 
@@ -70,30 +70,82 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
     glEnable(GL_SCISSOR_TEST);
     glActiveTexture(GL_TEXTURE0);
 
+    // Upload glyphs added to the font atlas since last frame (only with io.Fonts->DynamicGlyphs)
+    int dirty_x, dirty_y, dirty_w, dirty_h;
+    if (io.Fonts->GetTexDataDirtyRect(&dirty_x, &dirty_y, &dirty_w, &dirty_h))
+    {
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, dirty_x, dirty_y, dirty_w, dirty_h, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (dirty_y * width + dirty_x) * 4);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
     // Setup viewport, orthographic projection matrix
     glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
-    const float ortho_projection[4][4] =
+    float ortho_projection[4][4] =
     {
         { 2.0f/io.DisplaySize.x, 0.0f,                   0.0f, 0.0f },
         { 0.0f,                  2.0f/-io.DisplaySize.y, 0.0f, 0.0f },
         { 0.0f,                  0.0f,                  -1.0f, 0.0f },
         {-1.0f,                  1.0f,                   0.0f, 1.0f },
     };
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    // Fixed point positions and uv, see ImDrawVert in imgui.h
+    ortho_projection[0][0] /= IM_DRAWVERT_POS_SCALE;
+    ortho_projection[1][1] /= IM_DRAWVERT_POS_SCALE;
+    const float uv_scale = 1.0f / 65536.0f;
+#else
+    const float uv_scale = 1.0f;
+#endif
     glUseProgram(g_ShaderHandle);
     glUniform1i(g_AttribLocationTex, 0);
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    glUniform1f(g_AttribLocationUVScale, uv_scale);
     glBindVertexArray(g_VaoHandle);
 
+    // With io.DrawDataUseArenas, the vertices and indices of all lists are uploaded at once
+    const bool use_arenas = (draw_data->VtxOffsets != NULL);
+    if (use_arenas)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)draw_data->TotalVtxCount * sizeof(ImDrawVert), (const GLvoid*)draw_data->VtxArena, GL_STREAM_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)draw_data->TotalIdxCount * sizeof(ImDrawIdx), (const GLvoid*)draw_data->IdxArena, GL_STREAM_DRAW);
+    }
+
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        const ImDrawIdx* idx_buffer_offset = 0;
+        const ImDrawIdx* idx_buffer_offset = use_arenas ? (const ImDrawIdx*)0 + draw_data->IdxOffsets[n] : 0;
+        const GLint base_vertex = use_arenas ? draw_data->VtxOffsets[n] : 0;
 
-        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+        if (!use_arenas)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+            if (cmd_list->IdxSpans.Size > 0)
+            {
+                // Channels merged without copying (io.DrawListsUseIdxSpans): upload each span in order, followed by IdxBuffer
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->GetIdxCount() * sizeof(ImDrawIdx), NULL, GL_STREAM_DRAW);
+                GLintptr offset = 0;
+                for (int span_i = 0; span_i < cmd_list->IdxSpans.Size; span_i++)
+                {
+                    const ImDrawIdxSpan& span = cmd_list->IdxSpans[span_i];
+                    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, (GLsizeiptr)span.IdxCount * sizeof(ImDrawIdx), (const GLvoid*)span.IdxData);
+                    offset += (GLintptr)span.IdxCount * sizeof(ImDrawIdx);
+                }
+                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data);
+            }
+            else
+            {
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+            }
+        }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -105,8 +157,9 @@ void ImGui_ImplGlfwGL3_RenderDrawLists(ImDrawData* draw_data)
             else
             {
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
+                glUniform1i(g_AttribLocationDistanceField, (pcmd->TextureId == io.Fonts->TexID && io.Fonts->DistanceFieldGlyphs) ? 1 : 0);
                 glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);
+                glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset, base_vertex);
             }
             idx_buffer_offset += pcmd->ElemCount;
         }
@@ -209,6 +262,7 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
     const GLchar *vertex_shader =
         "#version 330\n"
         "uniform mat4 ProjMtx;\n"
+        "uniform float UVScale;\n"
         "in vec2 Position;\n"
         "in vec2 UV;\n"
         "in vec4 Color;\n"
@@ -216,7 +270,7 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
         "out vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "	Frag_UV = UV;\n"
+        "	Frag_UV = UV * UVScale;\n"
         "	Frag_Color = Color;\n"
         "	gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
@@ -224,12 +278,19 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
     const GLchar* fragment_shader =
         "#version 330\n"
         "uniform sampler2D Texture;\n"
+        "uniform int DistanceField;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "	Out_Color = Frag_Color * texture( Texture, Frag_UV.st);\n"
+        "	vec4 tex = texture( Texture, Frag_UV.st);\n"
+        "	if (DistanceField != 0)\n"
+        "	{\n"
+        "		float w = max(fwidth(tex.a), 1e-5);\n"
+        "		tex.a = clamp((tex.a - 0.5) / w + 0.5, 0.0, 1.0);\n"
+        "	}\n"
+        "	Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     g_ShaderHandle = glCreateProgram();
@@ -245,6 +306,8 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
 
     g_AttribLocationTex = glGetUniformLocation(g_ShaderHandle, "Texture");
     g_AttribLocationProjMtx = glGetUniformLocation(g_ShaderHandle, "ProjMtx");
+    g_AttribLocationUVScale = glGetUniformLocation(g_ShaderHandle, "UVScale");
+    g_AttribLocationDistanceField = glGetUniformLocation(g_ShaderHandle, "DistanceField");
     g_AttribLocationPosition = glGetAttribLocation(g_ShaderHandle, "Position");
     g_AttribLocationUV = glGetAttribLocation(g_ShaderHandle, "UV");
     g_AttribLocationColor = glGetAttribLocation(g_ShaderHandle, "Color");
@@ -260,8 +323,13 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
     glEnableVertexAttribArray(g_AttribLocationColor);
 
 #define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_SHORT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(g_AttribLocationUV, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
+#else
     glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, pos));
     glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, uv));
+#endif
     glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)OFFSETOF(ImDrawVert, col));
 #undef OFFSETOF
 
@@ -327,6 +395,8 @@ bool    ImGui_ImplGlfwGL3_Init(GLFWwindow* window, bool install_callbacks)
     io.KeyMap[ImGuiKey_Z] = GLFW_KEY_Z;
 
     io.RenderDrawListsFn = ImGui_ImplGlfwGL3_RenderDrawLists;       // Alternatively you can set this to NULL and call ImGui::GetDrawData() after ImGui::Render() to get the same ImDrawData pointer.
+    io.DrawListsUseIdxSpans = true;                                 // Our render function uploads ImDrawList::IdxSpans
+    io.DrawDataUseArenas = true;                                    // Our render function uploads ImDrawData::VtxArena/IdxArena in one go
     io.SetClipboardTextFn = ImGui_ImplGlfwGL3_SetClipboardText;
     io.GetClipboardTextFn = ImGui_ImplGlfwGL3_GetClipboardText;
     io.ClipboardUserData = g_Window;
@@ -0,0 +1,169 @@
+// ImGui - multi-threaded contexts stress test (no window, no GPU)
+// This runs N contexts on N threads at the same time, then runs them again one after the other on the main thread, and compares their output.
+// It needs IMGUI_THREAD_LOCAL_CONTEXT to be defined for all of ImGui (the Makefile passes it on the command line), so each thread has its own current context.
+// Usage: threads_example [contexts_count] [frames_count]
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#ifndef IMGUI_THREAD_LOCAL_CONTEXT
+#error "Build ImGui and this file with IMGUI_THREAD_LOCAL_CONTEXT defined."
+#endif
+
+// FNV-1a, accumulated over the vertices and indices of every frame
+static ImU32 HashBytes(const void* data, size_t size, ImU32 hash)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t n = 0; n < size; n++)
+        hash = (hash ^ p[n]) * 16777619u;
+    return hash;
+}
+
+static ImU32 HashDrawData(ImDrawData* draw_data, ImU32 hash)
+{
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        hash = HashBytes(cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert), hash);
+        for (int span_n = 0; span_n < cmd_list->IdxSpans.Size; span_n++)
+            hash = HashBytes(cmd_list->IdxSpans[span_n].IdxData, cmd_list->IdxSpans[span_n].IdxCount * sizeof(ImDrawIdx), hash);
+        hash = HashBytes(cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+            hash = HashBytes(&cmd_list->CmdBuffer[cmd_i].ClipRect, sizeof(ImVec4), hash);
+    }
+    return hash;
+}
+
+// Runs 'frames_count' frames of a UI which depends on 'seed' in the given context, returns the hash of the draw data of all frames.
+// Everything lives on the stack or in the context: ShowTestWindow() can't be used here as it keeps its state in static variables.
+static ImU32 RunContext(ImGuiContext* ctx, int seed, int frames_count)
+{
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.IniFilename = NULL;
+    io.DrawListsUseIdxSpans = (seed & 1) != 0;
+
+    char text[64] = "Hello";
+    float value = 0.5f;
+    bool check = false;
+    int clicks = 0;
+    ImU32 hash = 2166136261u;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        io.MousePos = ImVec2(50.0f + (float)((frame * (seed + 3)) % 400), 40.0f + (float)((frame * 7 + seed * 13) % 300));
+        io.MouseDown[0] = ((frame + seed) % 16) < 6;
+        io.MouseWheel = (frame % 50) == 25 ? -1.0f : 0.0f;
+        ImGui::NewFrame();
+
+        ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiSetCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(420, 360), ImGuiSetCond_FirstUseEver);
+        ImGui::Begin("Context");
+        ImGui::Text("Context %d, frame %d, clicks %d", seed, frame, clicks);
+        if (ImGui::Button("Click"))
+            clicks++;
+        ImGui::SameLine();
+        ImGui::Checkbox("Check", &check);
+        ImGui::SliderFloat("Value", &value, 0.0f, 1.0f);
+        ImGui::InputText("Text", text, (int)sizeof(text));
+        if (ImGui::CollapsingHeader("Lines", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            ImGui::BeginChild("Scrolling", ImVec2(0, 150), true);
+            for (int i = 0; i < 50 + seed * 10; i++)
+                ImGui::Text("%04d: line of context %d", i, seed);
+            ImGui::EndChild();
+        }
+        ImGui::Columns(3, "columns");
+        for (int i = 0; i < 12; i++)
+        {
+            ImGui::Text("Cell %d", i * (seed + 1));
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::End();
+
+        ImGui::SetNextWindowPos(ImVec2(500, 20), ImGuiSetCond_FirstUseEver);
+        ImGui::Begin("Shapes", NULL, ImGuiWindowFlags_AlwaysAutoResize);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        ImVec2 p = ImGui::GetCursorScreenPos();
+        draw_list->AddCircle(ImVec2(p.x + 50, p.y + 50), 30.0f + seed, IM_COL32(255, 255, 0, 255), 24, 2.0f);
+        draw_list->AddRectFilled(ImVec2(p.x + 100, p.y + 20), ImVec2(p.x + 160 + value * 40, p.y + 80), IM_COL32(0, 128, 255, 255), 4.0f);
+        draw_list->AddBezierCurve(p, ImVec2(p.x + 60, p.y + 120), ImVec2(p.x + 120, p.y - 20), ImVec2(p.x + 200, p.y + 100), IM_COL32(255, 255, 255, 255), 1.5f);
+        ImGui::Dummy(ImVec2(220, 120));
+        ImGui::End();
+
+        ImGui::Render();
+        hash = HashDrawData(ImGui::GetDrawData(), hash);
+    }
+
+    io.Fonts = NULL; // The font atlas is shared, don't let Shutdown() clear it
+    ImGui::Shutdown();
+    ImGui::SetCurrentContext(NULL);
+    return hash;
+}
+
+int main(int argc, char** argv)
+{
+    const int contexts_count = (argc > 1) ? atoi(argv[1]) : 8;
+    const int frames_count = (argc > 2) ? atoi(argv[2]) : 300;
+
+    // Build the shared font atlas before any thread uses it, it is only read from afterwards
+    ImGuiContext* default_ctx = ImGui::GetCurrentContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    atlas->GetTexDataAsAlpha8(&tex_pixels, &tex_w, &tex_h);
+
+    // Serial runs
+    std::vector<ImU32> serial_hashes(contexts_count);
+    for (int n = 0; n < contexts_count; n++)
+    {
+        ImGuiContext* ctx = ImGui::CreateContext();
+        ImGui::SetCurrentContext(ctx);
+        ImGui::GetIO().Fonts = atlas;
+        serial_hashes[n] = RunContext(ctx, n, frames_count);
+        ImGui::DestroyContext(ctx);
+    }
+
+    // Concurrent runs
+    std::vector<ImGuiContext*> contexts(contexts_count);
+    std::vector<ImU32> thread_hashes(contexts_count);
+    for (int n = 0; n < contexts_count; n++)
+    {
+        contexts[n] = ImGui::CreateContext();
+        ImGui::SetCurrentContext(contexts[n]);
+        ImGui::GetIO().Fonts = atlas;
+    }
+    ImGui::SetCurrentContext(NULL);
+    std::vector<std::thread> threads;
+    for (int n = 0; n < contexts_count; n++)
+        threads.push_back(std::thread([&, n]() { thread_hashes[n] = RunContext(contexts[n], n, frames_count); }));
+    for (size_t n = 0; n < threads.size(); n++)
+        threads[n].join();
+    for (int n = 0; n < contexts_count; n++)
+        ImGui::DestroyContext(contexts[n]);
+
+    // The default context owns the atlas, it must be current while they are released
+    ImGui::SetCurrentContext(default_ctx);
+    ImGui::Shutdown();
+
+    int errors = 0;
+    for (int n = 0; n < contexts_count; n++)
+    {
+        printf("Context %d: serial %08X, threaded %08X%s\n", n, serial_hashes[n], thread_hashes[n], serial_hashes[n] == thread_hashes[n] ? "" : " MISMATCH");
+        if (serial_hashes[n] != thread_hashes[n])
+            errors++;
+    }
+
+    if (errors)
+    {
+        printf("%d errors\n", errors);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,74 @@
+// ImGui - many windows benchmark (no window, no GPU)
+// Creates a large number of windows once, then submits only a few of them per frame and measures the time spent in NewFrame() and in the whole frame.
+// This is the case of applications with many tool windows of which only some are open: the cost of the windows which aren't submitted should stay small.
+// Usage: windows_benchmark [windows_count] [windows_submitted_per_frame] [frames_count]
+
+#include <imgui.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static double ElapsedMicroseconds(Clock::time_point t0, Clock::time_point t1)
+{
+    return std::chrono::duration<double, std::micro>(t1 - t0).count();
+}
+
+static void SubmitWindow(int n)
+{
+    char name[32];
+    sprintf(name, "Window %d", n);
+    ImGui::SetNextWindowPos(ImVec2((float)(20 + (n * 37) % 1000), (float)(20 + (n * 53) % 500)), ImGuiSetCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(200, 120), ImGuiSetCond_FirstUseEver);
+    ImGui::Begin(name);
+    ImGui::Text("Window %d", n);
+    ImGui::Button("Button");
+    ImGui::End();
+}
+
+int main(int argc, char** argv)
+{
+    const int windows_count = (argc > 1) ? atoi(argv[1]) : 10000;
+    const int windows_per_frame = (argc > 2) ? atoi(argv[2]) : 20;
+    const int frames_count = (argc > 3) ? atoi(argv[3]) : 1000;
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.IniFilename = NULL;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsAlpha8(&tex_pixels, &tex_w, &tex_h);
+
+    // Create all the windows, a few hundreds per frame
+    for (int n = 0; n < windows_count; n += 500)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        for (int i = n; i < n + 500 && i < windows_count; i++)
+            SubmitWindow(i);
+        ImGui::Render();
+    }
+
+    // Submit a different set of windows every frame, with the mouse moving over them
+    double new_frame_us = 0.0, frame_us = 0.0;
+    for (int frame = 0; frame < frames_count; frame++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        io.MousePos = ImVec2((float)((frame * 7) % 1280), (float)((frame * 3) % 720));
+        const Clock::time_point t0 = Clock::now();
+        ImGui::NewFrame();
+        const Clock::time_point t1 = Clock::now();
+        for (int i = 0; i < windows_per_frame; i++)
+            SubmitWindow((frame * windows_per_frame + i) % windows_count);
+        ImGui::Render();
+        const Clock::time_point t2 = Clock::now();
+        new_frame_us += ElapsedMicroseconds(t0, t1);
+        frame_us += ElapsedMicroseconds(t0, t2);
+    }
+
+    printf("%d windows, %d submitted per frame, %d frames\n", windows_count, windows_per_frame, frames_count);
+    printf("NewFrame(): %.1f us, whole frame: %.1f us (average)\n", new_frame_us / frames_count, frame_us / frames_count);
+    ImGui::Shutdown();
+    return 0;
+}
@@ -13,6 +13,9 @@
 //#define IMGUI_API __declspec( dllexport )
 //#define IMGUI_API __declspec( dllimport )
 
+//---- Make the current context pointer thread-local, so that different threads can each create and use their own context concurrently (see CreateContext()/SetCurrentContext())
+//#define IMGUI_THREAD_LOCAL_CONTEXT
+
 //---- Include imgui_user.h at the end of imgui.h
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
@@ -29,6 +32,10 @@
 //---- Pack colors to BGRA instead of RGBA (remove need to post process vertex buffer in back ends)
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
+//---- Use a compact 12 bytes ImDrawVert (16-bit fixed point positions and uv) instead of 20 bytes. Your renderer needs to handle it, see ImDrawVert in imgui.h.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+//#define IM_DRAWVERT_POS_FRAC_BITS 2
+
 //---- Implement STB libraries in a namespace to avoid conflicts
 //#define IMGUI_STB_NAMESPACE     ImGuiStb
 
@@ -672,7 +672,14 @@ static void             SetWindowPos(ImGuiWindow* window, const ImVec2& pos, ImG
 static void             SetWindowSize(ImGuiWindow* window, const ImVec2& size, ImGuiSetCond cond);
 static void             SetWindowCollapsed(ImGuiWindow* window, bool collapsed, ImGuiSetCond cond);
 static ImGuiWindow*     FindHoveredWindow(ImVec2 pos, bool excluding_childs);
+static void             UpdateWindowHotData(ImGuiWindow* window);
+static void             UpdateWindowHitGrid(ImGuiWindow* window, bool active);
+static void             UpdateWindowsHitGridLayout();
+static void             UpdateInputEvents();
 static ImGuiWindow*     CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags);
+static void             CompactWindowMemory(ImGuiWindow* window);
+static void             DestroyWindow(ImGuiWindow* window);
+static size_t           CalcWindowMemoryUsage(ImGuiWindow* window);
 static inline bool      IsWindowContentHoverable(ImGuiWindow* window);
 static void             ClearSetNextWindowData();
 static void             CheckStacksSize(ImGuiWindow* window, bool write);
@@ -726,13 +733,21 @@ static ImFontAtlas      GImDefaultFontAtlas;
 
 // Default context storage + current context pointer.
 // Implicitely used by all ImGui functions. Always assumed to be != NULL. Change to a different context by calling ImGui::SetCurrentContext()
-// ImGui is currently not thread-safe because of this variable. If you want thread-safety to allow N threads to access N different contexts, you might work around it by:
-// - Having multiple instances of the ImGui code compiled inside different namespace (easiest/safest, if you have a finite number of contexts)
-// - or: Changing this variable to be TLS. You may #define GImGui in imconfig.h for further custom hackery. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
+// A context is not thread-safe, but different contexts can be used concurrently by different threads if the current context pointer is thread-local:
+// - #define IMGUI_THREAD_LOCAL_CONTEXT in imconfig.h, then each thread calls ImGui::SetCurrentContext() with its own context created by ImGui::CreateContext().
+//   Every thread initially points to the default context, which must only be used by one thread at a time.
+// - Contexts may share a font atlas (the default) as long as it is built before the threads start using it, it is then only read from.
+//   Set io.Fonts = NULL before calling Shutdown() on a context sharing the atlas, as Shutdown() clears it.
+// - ShowTestWindow() and ShowMetricsWindow() use static variables for their own state and should only be called from one thread.
+// - Alternatively you may #define GImGui in imconfig.h for further custom hackery. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
 #ifndef GImGui
 static ImGuiContext     GImDefaultContext;
+#ifdef IMGUI_THREAD_LOCAL_CONTEXT
+IM_THREAD_LOCAL ImGuiContext* GImGui = &GImDefaultContext;
+#else
 ImGuiContext*           GImGui = &GImDefaultContext;
 #endif
+#endif
 
 //-----------------------------------------------------------------------------
 // User facing structures
@@ -817,6 +832,8 @@ ImGuiIO::ImGuiIO()
     DisplaySize = ImVec2(-1.0f, -1.0f);
     DeltaTime = 1.0f/60.0f;
     IniSavingRate = 5.0f;
+    WindowsCompactTimer = 60.0f;
+    WindowsDestroyTimer = -1.0f;
     IniFilename = "imgui.ini";
     LogFilename = "imgui_log.txt";
     Fonts = &GImDefaultFontAtlas;
@@ -837,6 +854,12 @@ ImGuiIO::ImGuiIO()
     KeyRepeatDelay = 0.250f;
     KeyRepeatRate = 0.050f;
     UserData = NULL;
+    DrawListsUseIdxSpans = false;
+    DrawDataUseArenas = false;
+    DrawBuffersPoolDecayFrames = 120;
+    ComboTypeAhead = true;
+    InputEventsTrickle = true;
+    TextLayoutCacheSize = 0;
 
     // User functions
     RenderDrawListsFn = NULL;
@@ -853,27 +876,105 @@ ImGuiIO::ImGuiIO()
 #endif
 }
 
+static void QueueInputEvent(ImGuiIO* io, const ImGuiInputEvent& e)
+{
+    IM_ASSERT(&GImGui->IO == io);     // Events are queued in the current context
+    (void)io;
+    GImGui->InputEventsQueue.push_back(e);
+}
+
 // Pass in translated ASCII characters for text input.
 // - with glfw you can get those from the callback set in glfwSetCharCallback()
 // - on Windows you can get those using ToAscii+keyboard state, or via the WM_CHAR message
+// Characters are queued and will be available to InputText() after the next NewFrame(), without any limit on their count.
 void ImGuiIO::AddInputCharacter(ImWchar c)
 {
-    const int n = ImStrlenW(InputCharacters);
-    if (n + 1 < IM_ARRAYSIZE(InputCharacters))
+    if (c == 0)
+        return;
+    ImGuiInputEvent e = ImGuiInputEvent();
+    e.Type = ImGuiInputEventType_Char;
+    e.Time = -1.0;
+    e.Char = c;
+    QueueInputEvent(this, e);
+}
+
+void ImGuiIO::AddInputCharactersUTF8(const char* utf8_chars)
+{
+    const char* utf8_chars_end = utf8_chars + strlen(utf8_chars);
+    while (utf8_chars < utf8_chars_end)
     {
-        InputCharacters[n] = c;
-        InputCharacters[n+1] = '\0';
+        unsigned int c = 0;
+        const int bytes = ImTextCharFromUtf8(&c, utf8_chars, utf8_chars_end);
+        if (bytes == 0)
+            break;
+        utf8_chars += bytes;
+        if (c > 0 && c <= 0xFFFF)
+            AddInputCharacter((ImWchar)c);
     }
 }
 
-void ImGuiIO::AddInputCharactersUTF8(const char* utf8_chars)
+void ImGuiIO::ClearInputCharacters()
+{
+    ImGuiContext& g = *GImGui;
+    InputCharacters[0] = 0;
+    g.InputCharacters.resize(0);    // Read by InputText() and the Combo() type-ahead for the current frame
+    ImVector<ImGuiInputEvent>& queue = g.InputEventsQueue;
+    int dst = 0;
+    for (int src = 0; src < queue.Size; src++)
+        if (queue[src].Type != ImGuiInputEventType_Char)
+            queue[dst++] = queue[src];
+    queue.resize(dst);
+}
+
+// Timestamped input events, queued and applied in order during the next NewFrame().
+// Pass time=-1.0 if the platform doesn't provide a timestamp, in which case ImGui's own clock is used.
+void ImGuiIO::AddMousePosEvent(float x, float y, double time)
 {
-    // We can't pass more wchars than ImGuiIO::InputCharacters[] can hold so don't convert more
-    const int wchars_buf_len = sizeof(ImGuiIO::InputCharacters) / sizeof(ImWchar);
-    ImWchar wchars[wchars_buf_len];
-    ImTextStrFromUtf8(wchars, wchars_buf_len, utf8_chars, NULL);
-    for (int i = 0; i < wchars_buf_len && wchars[i] != 0; i++)
-        AddInputCharacter(wchars[i]);
+    ImGuiInputEvent e = ImGuiInputEvent();
+    e.Type = ImGuiInputEventType_MousePos;
+    e.Time = time;
+    e.Pos = ImVec2(x, y);
+    QueueInputEvent(this, e);
+}
+
+void ImGuiIO::AddMouseButtonEvent(int button, bool down, double time)
+{
+    IM_ASSERT(button >= 0 && button < IM_ARRAYSIZE(MouseDown));
+    ImGuiInputEvent e = ImGuiInputEvent();
+    e.Type = ImGuiInputEventType_MouseButton;
+    e.Time = time;
+    e.Index = button;
+    e.Down = down;
+    QueueInputEvent(this, e);
+}
+
+void ImGuiIO::AddMouseWheelEvent(float wheel, double time)
+{
+    ImGuiInputEvent e = ImGuiInputEvent();
+    e.Type = ImGuiInputEventType_MouseWheel;
+    e.Time = time;
+    e.Wheel = wheel;
+    QueueInputEvent(this, e);
+}
+
+void ImGuiIO::AddKeyEvent(int key_index, bool down, double time)
+{
+    IM_ASSERT(key_index >= 0 && key_index < IM_ARRAYSIZE(KeysDown));
+    ImGuiInputEvent e = ImGuiInputEvent();
+    e.Type = ImGuiInputEventType_Key;
+    e.Time = time;
+    e.Index = key_index;
+    e.Down = down;
+    QueueInputEvent(this, e);
+}
+
+void ImGuiIO::AddKeyModsEvent(bool ctrl, bool shift, bool alt, bool super, double time)
+{
+    ImGuiInputEvent e = ImGuiInputEvent();
+    e.Type = ImGuiInputEventType_KeyMods;
+    e.Time = time;
+    e.Index = (ctrl ? 1 : 0) | (shift ? 2 : 0) | (alt ? 4 : 0) | (super ? 8 : 0);
+    QueueInputEvent(this, e);
 }
 
 //-----------------------------------------------------------------------------
@@ -988,22 +1089,189 @@ int ImFormatStringV(char* buf, int buf_size, const char* fmt, va_list args)
     return w;
 }
 
+// Fast paths of FormatScalar() for the common numeric formats, matching printf output.
+// Floats are decomposed as m*2^e and scaled with exact integer arithmetic, so rounding is the same as printf (to nearest, ties to even).
+// Up to 10^11: "%.6g" of values just below 1e-4 (1e-4f itself is 9.99999975e-05) scales by 10^(6-1+5), then 10^11 if rounding gives one digit less.
+static const unsigned long long GPow10[12] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL };
+
+// Round v*10^pow10_exp to an integer. v must be >= 0 and < 1e9, pow10_exp in [-11,11] with v*10^pow10_exp < 1e18.
+// The 24 bits mantissa times 10^11 stays below 2^64.
+static unsigned long long ImRoundScaledFloat(float v, int pow10_exp)
+{
+    IM_ASSERT(pow10_exp > -IM_ARRAYSIZE(GPow10) && pow10_exp < IM_ARRAYSIZE(GPow10));
+    int e;
+    const float f = frexpf(v, &e);
+    unsigned long long num = (unsigned long long)(f * 16777216.0f);    // v = num * 2^(e-24), exactly
+    unsigned long long den = 1;
+    e -= 24;
+    if (pow10_exp >= 0)
+        num *= GPow10[pow10_exp];
+    else
+        den = GPow10[-pow10_exp];
+    if (e >= 0)
+    {
+        num <<= e;
+    }
+    else
+    {
+        if (-e >= 60)       // num < 2^54 so the result rounds to zero
+            return 0;
+        den <<= -e;
+    }
+    unsigned long long q = num / den, r = num - q * den;
+    if (r * 2 > den || (r * 2 == den && (q & 1)))
+        q++;
+    return q;
+}
+
+static inline bool ImFloatSignBit(float v)
+{
+    unsigned int bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return (bits >> 31) != 0;
+}
+
+// Write the decimal digits of v, zero padded to at least min_digits
+static char* ImWriteDigits(char* p, unsigned long long v, int min_digits)
+{
+    char tmp[24];
+    int n = 0;
+    do { tmp[n++] = (char)('0' + (int)(v % 10)); v /= 10; } while (v != 0);
+    while (n < min_digits)
+        tmp[n++] = '0';
+    while (n > 0)
+        *p++ = tmp[--n];
+    return p;
+}
+
+// "%d". Returns length
+static int ImFormatInt(char* buf, int v)
+{
+    char* p = buf;
+    unsigned int u = (unsigned int)v;
+    if (v < 0)
+    {
+        *p++ = '-';
+        u = 0u - u;
+    }
+    p = ImWriteDigits(p, u, 1);
+    *p = 0;
+    return (int)(p - buf);
+}
+
+// "%.Nf" with N in [0,9]. Returns length, or -1 if the value is out of range of the fast path
+static int ImFormatFloatFixed(char* buf, float v, int precision)
+{
+    const float av = fabsf(v);
+    if (!(av < 1e9f) || precision < 0 || precision > 9)     // Also rejects NaN
+        return -1;
+    char* p = buf;
+    if (ImFloatSignBit(v))
+        *p++ = '-';
+    const unsigned long long q = ImRoundScaledFloat(av, precision);
+    p = ImWriteDigits(p, q / GPow10[precision], 1);
+    if (precision > 0)
+    {
+        *p++ = '.';
+        p = ImWriteDigits(p, q % GPow10[precision], precision);
+    }
+    *p = 0;
+    return (int)(p - buf);
+}
+
+// "%.Ng" with N in [1,6]. Returns length, or -1 if the value is out of range of the fast path
+static int ImFormatFloatGeneral(char* buf, float v, int precision)
+{
+    const float av = fabsf(v);
+    if (precision < 1 || precision > 6 || !(av == 0.0f || (av >= 1e-4f && av < 1e9f)))
+        return -1;
+    char* p = buf;
+    if (ImFloatSignBit(v))
+        *p++ = '-';
+    if (av == 0.0f)
+    {
+        *p++ = '0';
+        *p = 0;
+        return (int)(p - buf);
+    }
+
+    // Round to 'precision' significant digits: q has exactly 'precision' digits and v ~= q * 10^(exponent-precision+1)
+    // With av >= 1e-4f exponent is >= -5, so the scale 10^(precision-1-exponent) is at most 10^11 including the adjustment below.
+    int exponent = (int)floor(log10((double)av));
+    unsigned long long q = ImRoundScaledFloat(av, precision - 1 - exponent);
+    if (q >= GPow10[precision])
+        q = ImRoundScaledFloat(av, precision - 1 - (++exponent));
+    else if (q < GPow10[precision - 1])
+        q = ImRoundScaledFloat(av, precision - 1 - (--exponent));
+
+    // Same style selection as printf, then trailing zeros are removed
+    const bool scientific = (exponent < -4 || exponent >= precision);
+    const int decimals = scientific ? precision - 1 : precision - 1 - exponent;
+    p = ImWriteDigits(p, q / GPow10[decimals], 1);
+    unsigned long long frac = q % GPow10[decimals];
+    int frac_digits = decimals;
+    while (frac_digits > 0 && (frac % 10) == 0)
+    {
+        frac /= 10;
+        frac_digits--;
+    }
+    if (frac_digits > 0)
+    {
+        *p++ = '.';
+        p = ImWriteDigits(p, frac, frac_digits);
+    }
+    if (scientific)
+    {
+        *p++ = 'e';
+        *p++ = (exponent < 0) ? '-' : '+';
+        p = ImWriteDigits(p, (unsigned long long)(exponent < 0 ? -exponent : exponent), 2);
+    }
+    *p = 0;
+    return (int)(p - buf);
+}
+
 // Pass data_size==0 for zero-terminated strings
 // FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// CRC32 lookup table (polynomial 0xEDB88320). Constant, so hashing doesn't need any lazy initialization which would race between threads using different contexts.
+static const ImU32 GCrc32LookupTable[256] =
+{
+    0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,
+    0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
+    0x1DB71064,0x6AB020F2,0xF3B97148,0x84BE41DE,0x1ADAD47D,0x6DDDE4EB,0xF4D4B551,0x83D385C7,
+    0x136C9856,0x646BA8C0,0xFD62F97A,0x8A65C9EC,0x14015C4F,0x63066CD9,0xFA0F3D63,0x8D080DF5,
+    0x3B6E20C8,0x4C69105E,0xD56041E4,0xA2677172,0x3C03E4D1,0x4B04D447,0xD20D85FD,0xA50AB56B,
+    0x35B5A8FA,0x42B2986C,0xDBBBC9D6,0xACBCF940,0x32D86CE3,0x45DF5C75,0xDCD60DCF,0xABD13D59,
+    0x26D930AC,0x51DE003A,0xC8D75180,0xBFD06116,0x21B4F4B5,0x56B3C423,0xCFBA9599,0xB8BDA50F,
+    0x2802B89E,0x5F058808,0xC60CD9B2,0xB10BE924,0x2F6F7C87,0x58684C11,0xC1611DAB,0xB6662D3D,
+    0x76DC4190,0x01DB7106,0x98D220BC,0xEFD5102A,0x71B18589,0x06B6B51F,0x9FBFE4A5,0xE8B8D433,
+    0x7807C9A2,0x0F00F934,0x9609A88E,0xE10E9818,0x7F6A0DBB,0x086D3D2D,0x91646C97,0xE6635C01,
+    0x6B6B51F4,0x1C6C6162,0x856530D8,0xF262004E,0x6C0695ED,0x1B01A57B,0x8208F4C1,0xF50FC457,
+    0x65B0D9C6,0x12B7E950,0x8BBEB8EA,0xFCB9887C,0x62DD1DDF,0x15DA2D49,0x8CD37CF3,0xFBD44C65,
+    0x4DB26158,0x3AB551CE,0xA3BC0074,0xD4BB30E2,0x4ADFA541,0x3DD895D7,0xA4D1C46D,0xD3D6F4FB,
+    0x4369E96A,0x346ED9FC,0xAD678846,0xDA60B8D0,0x44042D73,0x33031DE5,0xAA0A4C5F,0xDD0D7CC9,
+    0x5005713C,0x270241AA,0xBE0B1010,0xC90C2086,0x5768B525,0x206F85B3,0xB966D409,0xCE61E49F,
+    0x5EDEF90E,0x29D9C998,0xB0D09822,0xC7D7A8B4,0x59B33D17,0x2EB40D81,0xB7BD5C3B,0xC0BA6CAD,
+    0xEDB88320,0x9ABFB3B6,0x03B6E20C,0x74B1D29A,0xEAD54739,0x9DD277AF,0x04DB2615,0x73DC1683,
+    0xE3630B12,0x94643B84,0x0D6D6A3E,0x7A6A5AA8,0xE40ECF0B,0x9309FF9D,0x0A00AE27,0x7D079EB1,
+    0xF00F9344,0x8708A3D2,0x1E01F268,0x6906C2FE,0xF762575D,0x806567CB,0x196C3671,0x6E6B06E7,
+    0xFED41B76,0x89D32BE0,0x10DA7A5A,0x67DD4ACC,0xF9B9DF6F,0x8EBEEFF9,0x17B7BE43,0x60B08ED5,
+    0xD6D6A3E8,0xA1D1937E,0x38D8C2C4,0x4FDFF252,0xD1BB67F1,0xA6BC5767,0x3FB506DD,0x48B2364B,
+    0xD80D2BDA,0xAF0A1B4C,0x36034AF6,0x41047A60,0xDF60EFC3,0xA867DF55,0x316E8EEF,0x4669BE79,
+    0xCB61B38C,0xBC66831A,0x256FD2A0,0x5268E236,0xCC0C7795,0xBB0B4703,0x220216B9,0x5505262F,
+    0xC5BA3BBE,0xB2BD0B28,0x2BB45A92,0x5CB36A04,0xC2D7FFA7,0xB5D0CF31,0x2CD99E8B,0x5BDEAE1D,
+    0x9B64C2B0,0xEC63F226,0x756AA39C,0x026D930A,0x9C0906A9,0xEB0E363F,0x72076785,0x05005713,
+    0x95BF4A82,0xE2B87A14,0x7BB12BAE,0x0CB61B38,0x92D28E9B,0xE5D5BE0D,0x7CDCEFB7,0x0BDBDF21,
+    0x86D3D2D4,0xF1D4E242,0x68DDB3F8,0x1FDA836E,0x81BE16CD,0xF6B9265B,0x6FB077E1,0x18B74777,
+    0x88085AE6,0xFF0F6A70,0x66063BCA,0x11010B5C,0x8F659EFF,0xF862AE69,0x616BFFD3,0x166CCF45,
+    0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,
+    0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
+    0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,
+    0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
+};
+
 ImU32 ImHash(const void* data, int data_size, ImU32 seed)
 {
-    static ImU32 crc32_lut[256] = { 0 };
-    if (!crc32_lut[1])
-    {
-        const ImU32 polynomial = 0xEDB88320;
-        for (ImU32 i = 0; i < 256; i++)
-        {
-            ImU32 crc = i;
-            for (ImU32 j = 0; j < 8; j++)
-                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & polynomial);
-            crc32_lut[i] = crc;
-        }
-    }
+    const ImU32* crc32_lut = GCrc32LookupTable;
 
     seed = ~seed;
     ImU32 crc = seed;
@@ -1228,10 +1496,40 @@ ImU32 ImGui::ColorConvertFloat4ToU32(const ImVec4& in)
     return out;
 }
 
+static void BakeStyleColors(const ImGuiStyle& style, ImU32* out_colors)
+{
+    for (int n = 0; n < ImGuiCol_COUNT; n++)
+        out_colors[n] = ImGui::ColorConvertFloat4ToU32(style.Colors[n]);
+}
+
+static void SetStyleColorsU32(const ImGuiStyle& style, const ImU32* colors_u32)
+{
+    ImGuiContext& g = *GImGui;
+    memcpy(g.StyleColorsU32, colors_u32, sizeof(g.StyleColorsU32));
+    memcpy(g.StyleColorsU32Source, style.Colors, sizeof(g.StyleColorsU32Source));
+}
+
+// Packed style colors are kept with the float color they were computed from. The style may be modified in place at any time
+// (e.g. through the reference returned by GetStyle()), so an entry is compared with the current style before being used, and only converted again if it differs.
+// Style.Alpha is applied on lookup by replacing the alpha byte, so changing it (e.g. PushStyleVar(ImGuiStyleVar_Alpha)) doesn't invalidate anything.
 ImU32 ImGui::GetColorU32(ImGuiCol idx, float alpha_mul)  
 { 
-    ImVec4 c = GImGui->Style.Colors[idx]; 
-    c.w *= GImGui->Style.Alpha * alpha_mul; 
+    ImGuiContext& g = *GImGui;
+    if (alpha_mul == 1.0f)
+    {
+        const ImVec4& col = g.Style.Colors[idx];
+        ImVec4& src = g.StyleColorsU32Source[idx];
+        if (col.x != src.x || col.y != src.y || col.z != src.z || col.w != src.w)
+        {
+            src = col;
+            g.StyleColorsU32[idx] = ColorConvertFloat4ToU32(col);
+        }
+        if (g.Style.Alpha == 1.0f)
+            return g.StyleColorsU32[idx];
+        return (g.StyleColorsU32[idx] & ~IM_COL32_A_MASK) | ((ImU32)IM_F32_TO_INT8_SAT(col.w * g.Style.Alpha) << IM_COL32_A_SHIFT);
+    }
+    ImVec4 c = g.Style.Colors[idx]; 
+    c.w *= g.Style.Alpha * alpha_mul; 
     return ColorConvertFloat4ToU32(c); 
 }
 
@@ -1480,15 +1778,10 @@ void ImGuiStorage::SetAllInt(int v)
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
 {
     if (default_filter)
-    {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
-        Build();
-    }
     else
-    {
         InputBuf[0] = 0;
-        CountGrep = 0;
-    }
+    Build();
 }
 
 bool ImGuiTextFilter::Draw(const char* label, float width)
@@ -1536,34 +1829,129 @@ void ImGuiTextFilter::Build()
         if (Filters[i].front() != '-')
             CountGrep += 1;
     }
-}
 
-bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
-{
-    if (Filters.empty())
-        return true;
+    LinesPassed.resize(0);
+    LinesSrc = NULL;
+    LinesCount = 0;
 
-    if (text == NULL)
-        text = "";
+    // Assign a character class to each case-folded byte used by the filters, so the transition table only needs as many columns as there are distinct characters.
+    memset(CharClass, 0, sizeof(CharClass));
+    CharClassCount = 1;
+    int states_max = 1;
+    for (int i = 0; i != Filters.Size; i++)
+    {
+        const char* p = (!Filters[i].empty() && Filters[i].front() == '-') ? Filters[i].begin() + 1 : Filters[i].begin();
+        states_max += (int)(Filters[i].end() - p);
+        for (; p < Filters[i].end(); p++)
+        {
+            const int c = toupper(*(const unsigned char*)p);
+            if (CharClass[c] == 0)
+                CharClass[c] = (unsigned char)CharClassCount++;
+        }
+    }
+    for (int c = 0; c < 256; c++)
+        CharClass[c] = CharClass[toupper(c)];
 
+    StateNext.resize(0);
+    StateFilterIdx.resize(0);
+    if (Filters.empty())
+        return;
+
+    // Build a trie of all patterns. 0xFFFF marks a missing edge until the automaton is completed below.
+    const int classes = CharClassCount;
+    StateNext.reserve(states_max * classes);
+    StateFilterIdx.reserve(states_max);
+    StateNext.resize(classes);
+    memset(StateNext.Data, 0xFF, (size_t)classes * sizeof(unsigned short));
+    StateFilterIdx.push_back(-1);
     for (int i = 0; i != Filters.Size; i++)
     {
         const TextRange& f = Filters[i];
-        if (f.empty())
+        const char* p = (!f.empty() && f.front() == '-') ? f.begin() + 1 : f.begin();
+        if (p == f.end())
             continue;
-        if (f.front() == '-')
+        int state = 0;
+        for (; p < f.end(); p++)
         {
-            // Subtract
-            if (ImStristr(text, text_end, f.begin()+1, f.end()) != NULL)
-                return false;
+            const int edge = state * classes + CharClass[*(const unsigned char*)p];
+            if (StateNext[edge] == 0xFFFF)
+            {
+                StateNext[edge] = (unsigned short)StateFilterIdx.Size;
+                StateNext.resize(StateNext.Size + classes);
+                memset(StateNext.Data + StateNext.Size - classes, 0xFF, (size_t)classes * sizeof(unsigned short));
+                StateFilterIdx.push_back(-1);
+            }
+            state = StateNext[edge];
         }
-        else
+        if (StateFilterIdx[state] == -1)
+            StateFilterIdx[state] = (short)i;
+    }
+
+    // Breadth-first pass to compute failure links, turning the trie into a complete transition table.
+    // Each state inherits the lowest filter index matched by its failure state (= longest proper suffix also present in the trie).
+    ImVector<int> fail, queue;
+    fail.resize(StateFilterIdx.Size);
+    queue.reserve(StateFilterIdx.Size);
+    for (int c = 0; c < classes; c++)
+    {
+        const int next = StateNext[c];
+        if (next == 0xFFFF)
         {
-            // Grep
-            if (ImStristr(text, text_end, f.begin(), f.end()) != NULL)
-                return true;
+            StateNext[c] = 0;
+            continue;
         }
+        fail[next] = 0;
+        queue.push_back(next);
     }
+    for (int queue_idx = 0; queue_idx < queue.Size; queue_idx++)
+    {
+        const int state = queue[queue_idx];
+        const int state_fail = fail[state];
+        if (StateFilterIdx[state_fail] != -1 && (StateFilterIdx[state] == -1 || StateFilterIdx[state_fail] < StateFilterIdx[state]))
+            StateFilterIdx[state] = StateFilterIdx[state_fail];
+        for (int c = 0; c < classes; c++)
+        {
+            const int next = StateNext[state * classes + c];
+            if (next == 0xFFFF)
+            {
+                StateNext[state * classes + c] = StateNext[state_fail * classes + c];
+                continue;
+            }
+            fail[next] = StateNext[state_fail * classes + c];
+            queue.push_back(next);
+        }
+    }
+}
+
+bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
+{
+    if (Filters.empty())
+        return true;
+
+    if (text == NULL)
+        text = "";
+    if (text_end == NULL)
+        text_end = text + strlen(text);
+
+    // Single pass over the text. The lowest index filter found decides, which is equivalent to testing each filter in order.
+    const unsigned short* state_next = StateNext.Data;
+    const short* state_filter_idx = StateFilterIdx.Data;
+    const int classes = CharClassCount;
+    int state = 0;
+    int match_idx = INT_MAX;
+    for (const unsigned char* p = (const unsigned char*)text; p < (const unsigned char*)text_end; p++)
+    {
+        state = state_next[state * classes + CharClass[*p]];
+        const int idx = state_filter_idx[state];
+        if (idx >= 0 && idx < match_idx)
+        {
+            match_idx = idx;
+            if (match_idx == 0)
+                break;
+        }
+    }
+    if (match_idx != INT_MAX)
+        return Filters[match_idx].front() != '-';   // Grep or Subtract
 
     // Implicit * grep
     if (CountGrep == 0)
@@ -1572,6 +1960,39 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+static bool TextFilter_ArrayGetter(void* data, int idx, const char** out_text, const char** out_text_end)
+{
+    const char* const* lines = (const char* const*)data;
+    *out_text = lines[idx];
+    *out_text_end = NULL;
+    return true;
+}
+
+const ImVector<int>& ImGuiTextFilter::PassFilterLines(const char* const* lines, int lines_count)
+{
+    return PassFilterLines(TextFilter_ArrayGetter, (void*)lines, lines_count);
+}
+
+const ImVector<int>& ImGuiTextFilter::PassFilterLines(bool (*lines_getter)(void*, int, const char**, const char**), void* data, int lines_count)
+{
+    // Start over if the source changed or lines were removed, otherwise only filter the newly appended lines
+    if (LinesSrc != data || lines_count < LinesCount)
+    {
+        LinesPassed.resize(0);
+        LinesSrc = data;
+        LinesCount = 0;
+    }
+    for (int i = LinesCount; i < lines_count; i++)
+    {
+        const char* text;
+        const char* text_end;
+        if (lines_getter(data, i, &text, &text_end) && PassFilter(text, text_end))
+            LinesPassed.push_back(i);
+    }
+    LinesCount = lines_count;
+    return LinesPassed;
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -1588,20 +2009,34 @@ void ImGuiTextBuffer::appendv(const char* fmt, va_list args)
     va_list args_copy;
     va_copy(args_copy, args);
 
-    int len = vsnprintf(NULL, 0, fmt, args);         // FIXME-OPT: could do a first pass write attempt, likely successful on first pass.
-    if (len <= 0)
-        return;
-
+    // Attempt to format directly into the spare capacity, which is likely to succeed. We write over the current zero-terminator.
     const int write_off = Buf.Size;
-    const int needed_sz = write_off + len;
-    if (write_off + len >= Buf.Capacity)
+    const int avail = Buf.Capacity - write_off + 1;
+    int len = vsnprintf(Buf.Data + write_off - 1, (size_t)avail, fmt, args);
+    if (len < 0 || len >= avail)
     {
+        // Didn't fit: measure if vsnprintf() didn't tell us (MSVC returns -1 on overflow), grow and write again
+        if (len < 0)
+        {
+            va_list args_measure;
+            va_copy(args_measure, args_copy);
+            len = vsnprintf(NULL, 0, fmt, args_measure);
+            va_end(args_measure);
+        }
+        if (len <= 0)
+        {
+            Buf.Data[write_off - 1] = 0;
+            va_end(args_copy);
+            return;
+        }
+
+        const int needed_sz = write_off + len;
         int double_capacity = Buf.Capacity * 2;
         Buf.reserve(needed_sz > double_capacity ? needed_sz : double_capacity);
+        ImFormatStringV(Buf.Data + write_off - 1, len+1, fmt, args_copy);
     }
-
-    Buf.resize(needed_sz);
-    ImFormatStringV(&Buf[write_off] - 1, len+1, fmt, args_copy);
+    va_end(args_copy);
+    Buf.resize(write_off + len);
 }
 
 void ImGuiTextBuffer::append(const char* fmt, ...)
@@ -1612,6 +2047,85 @@ void ImGuiTextBuffer::append(const char* fmt, ...)
     va_end(args);
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiTextChunkedBuffer
+//-----------------------------------------------------------------------------
+
+void ImGuiTextChunkedBuffer::clear()
+{
+    for (int i = 0; i < Chunks.Size; i++)
+        ImGui::MemFree(Chunks[i]);
+    Chunks.clear();
+    Lines.clear();
+    LineBegin = WritePtr = WriteEnd = NULL;
+    TextSize = 0;
+}
+
+// Start a new chunk with room for 'len' more bytes + zero-terminator. The line being appended is moved to the new chunk so that every line stays contiguous.
+static void TextChunkedBufferAddChunk(ImGuiTextChunkedBuffer* buf, int len)
+{
+    const int partial_len = (int)(buf->WritePtr - buf->LineBegin);
+    const int chunk_size = ImMax(buf->ChunkSize, partial_len + len + 1);
+    char* chunk = (char*)ImGui::MemAlloc((size_t)chunk_size);
+    if (partial_len > 0)
+        memcpy(chunk, buf->LineBegin, (size_t)partial_len);
+    buf->Chunks.push_back(chunk);
+    buf->LineBegin = chunk;
+    buf->WritePtr = chunk + partial_len;
+    buf->WriteEnd = chunk + chunk_size;
+}
+
+void ImGuiTextChunkedBuffer::appendv(const char* fmt, va_list args)
+{
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    // Attempt to format directly into the current chunk, which is likely to succeed
+    const int avail = (int)(WriteEnd - WritePtr);
+    int len = vsnprintf(WritePtr, (size_t)avail, fmt, args);
+    if (len < 0 || len >= avail)
+    {
+        // Didn't fit: measure if vsnprintf() didn't tell us (MSVC returns -1 on overflow), start a new chunk and write again
+        if (len < 0)
+        {
+            va_list args_measure;
+            va_copy(args_measure, args_copy);
+            len = vsnprintf(NULL, 0, fmt, args_measure);
+            va_end(args_measure);
+        }
+        if (len > 0)
+        {
+            TextChunkedBufferAddChunk(this, len);
+            ImFormatStringV(WritePtr, len+1, fmt, args_copy);
+        }
+    }
+    va_end(args_copy);
+    if (len <= 0)
+        return;
+
+    // Index new lines
+    char* text = WritePtr;
+    char* text_end = WritePtr + len;
+    while (char* line_end = (char*)memchr(text, '\n', (size_t)(text_end - text)))
+    {
+        Line line;
+        line.b = LineBegin;
+        line.e = line_end;
+        Lines.push_back(line);
+        LineBegin = text = line_end + 1;
+    }
+    WritePtr = text_end;
+    TextSize += len;
+}
+
+void ImGuiTextChunkedBuffer::append(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    appendv(fmt, args);
+    va_end(args);
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiSimpleColumns
 //-----------------------------------------------------------------------------
@@ -1740,6 +2254,209 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+//-----------------------------------------------------------------------------
+// ImGuiTreeClipper
+//-----------------------------------------------------------------------------
+
+ImGuiID ImGuiTreeClipper::GetNodeID(int node) const
+{
+    return ImHash(&node, sizeof(node), ID);
+}
+
+// Append the visible descendants of 'node' to TempRows, in display order.
+// Iterative depth-first traversal with an explicit stack (in TempRows itself) so deep hierarchies don't blow the C stack.
+static void TreeClipperGatherRows(ImGuiTreeClipper* tree, int node, int depth, ImVector<ImGuiTreeClipper::Row>& out_rows)
+{
+    ImVector<ImGuiTreeClipper::Row>& stack = tree->TempRows;
+    ImVector<int>& children = tree->TempChildren;
+    stack.resize(0);
+    children.resize(0);
+    tree->ChildrenGetter(tree->UserData, node, &children);
+    for (int n = children.Size - 1; n >= 0; n--)
+    {
+        ImGuiTreeClipper::Row row = { children[n], depth, false, false };
+        stack.push_back(row);
+    }
+    while (stack.Size > 0)
+    {
+        ImGuiTreeClipper::Row row = stack.back();
+        stack.pop_back();
+        children.resize(0);
+        tree->ChildrenGetter(tree->UserData, row.Node, &children);
+        row.HasChildren = children.Size > 0;
+        row.Open = row.HasChildren && tree->Storage->GetInt(tree->GetNodeID(row.Node), 0) != 0;
+        out_rows.push_back(row);
+        if (row.Open)
+            for (int n = children.Size - 1; n >= 0; n--)
+            {
+                ImGuiTreeClipper::Row child = { children[n], row.Depth + 1, false, false };
+                stack.push_back(child);
+            }
+    }
+}
+
+void ImGuiTreeClipper::Begin(const char* str_id, void (*children_getter)(void* data, int node, ImVector<int>* out_children), void* data)
+{
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImGuiID id = window->GetID(str_id);
+    if (id != ID || window->DC.StateStorage != Storage || children_getter != ChildrenGetter || data != UserData)
+        RowsValid = false;
+    ID = id;
+    Storage = window->DC.StateStorage;
+    ChildrenGetter = children_getter;
+    UserData = data;
+    StartPosY = ImGui::GetCursorPosY();
+    StepNo = 0;
+    DisplayStart = DisplayEnd = 0;
+    if (!RowsValid)
+    {
+        Rows.resize(0);
+        TreeClipperGatherRows(this, -1, 0, Rows);
+        RowsValid = true;
+    }
+}
+
+bool ImGuiTreeClipper::Step()
+{
+    ImGuiContext& g = *GImGui;
+    if (StepNo == 0)
+    {
+        if (Rows.Size == 0 || ImGui::GetCurrentWindowRead()->SkipItems)
+        {
+            StepNo = 3;
+            return false;
+        }
+        if (RowHeight <= 0.0f)
+        {
+            // Display the first row to measure it
+            DisplayStart = 0;
+            DisplayEnd = 1;
+            StepNo = 1;
+            return true;
+        }
+        StepNo = 2;
+    }
+    if (StepNo == 1 || StepNo == 2)
+    {
+        if (StepNo == 1)
+        {
+            RowHeight = ImGui::GetCursorPosY() - StartPosY;
+            IM_ASSERT(RowHeight > 0.0f);    // If this triggers, it means the first row hasn't moved the cursor vertically
+        }
+        int start, end;
+        ImGui::SetCursorPosY(StartPosY);
+        ImGui::CalcListClipping(Rows.Size, RowHeight, &start, &end);
+        if (StepNo == 1)
+        {
+            start = ImMax(start, 1);
+            end = ImMax(end, start);
+        }
+        SetCursorPosYAndSetupDummyPrevLine(StartPosY + start * RowHeight, RowHeight);
+        DisplayStart = start;
+        DisplayEnd = end;
+        StepNo = 3;
+        return true;
+    }
+    if (StepNo == 3)
+    {
+        // Refresh the row height from what was displayed (e.g. font or style changes), then advance cursor to the end of the rows
+        if (DisplayEnd > DisplayStart && !g.LogEnabled)
+        {
+            const float row_height = (ImGui::GetCursorPosY() - (StartPosY + DisplayStart * RowHeight)) / (DisplayEnd - DisplayStart);
+            if (row_height > 0.0f && fabsf(row_height - RowHeight) >= 0.5f)
+                RowHeight = row_height;
+        }
+        SetCursorPosYAndSetupDummyPrevLine(StartPosY + Rows.Size * RowHeight, RowHeight);
+        StepNo = 4;
+    }
+    return false;
+}
+
+bool ImGuiTreeClipper::TreeNode(int row_n, const char* label, ImGuiTreeNodeFlags flags)
+{
+    const Row& row = Rows[row_n];
+    const float indent_w = row.Depth * GImGui->Style.IndentSpacing;
+    if (indent_w > 0.0f)
+        ImGui::Indent(indent_w);
+    if (!row.HasChildren)
+        flags |= ImGuiTreeNodeFlags_Leaf;
+    bool is_open = ImGui::TreeNodeBehavior(GetNodeID(row.Node), flags | ImGuiTreeNodeFlags_NoTreePushOnOpen, label);
+    if (indent_w > 0.0f)
+        ImGui::Unindent(indent_w);
+    if (row.HasChildren && is_open != row.Open)
+        SetNodeOpen(row_n, is_open);
+    return is_open;
+}
+
+// Rows below 'row' are shifted but DisplayEnd is left untouched so the number of rows submitted this frame doesn't change: the loop will carry on with the newly inserted rows.
+void ImGuiTreeClipper::SetNodeOpen(int row_n, bool is_open)
+{
+    IM_ASSERT(row_n >= 0 && row_n < Rows.Size);
+    Row& row = Rows[row_n];
+    if (!row.HasChildren)
+        return;
+    Storage->SetInt(GetNodeID(row.Node), is_open ? 1 : 0);
+    if (row.Open == is_open)
+        return;
+    row.Open = is_open;
+    if (is_open)
+    {
+        // Insert visible descendants after the node
+        ImVector<Row> new_rows;
+        TreeClipperGatherRows(this, row.Node, row.Depth + 1, new_rows);
+        const int insert_count = new_rows.Size;
+        if (insert_count > 0)
+        {
+            const int move_count = Rows.Size - (row_n + 1);
+            Rows.resize(Rows.Size + insert_count);
+            memmove(Rows.Data + row_n + 1 + insert_count, Rows.Data + row_n + 1, (size_t)move_count * sizeof(Row));
+            memcpy(Rows.Data + row_n + 1, new_rows.Data, (size_t)insert_count * sizeof(Row));
+        }
+    }
+    else
+    {
+        // Remove descendants, which are all the following rows with a greater depth
+        const int depth = row.Depth;
+        int end = row_n + 1;
+        while (end < Rows.Size && Rows[end].Depth > depth)
+            end++;
+        const int remove_count = end - (row_n + 1);
+        if (remove_count > 0)
+        {
+            memmove(Rows.Data + row_n + 1, Rows.Data + end, (size_t)(Rows.Size - end) * sizeof(Row));
+            Rows.resize(Rows.Size - remove_count);
+        }
+        DisplayEnd = ImMin(DisplayEnd, Rows.Size);
+    }
+}
+
+void ImGuiTreeClipper::ScrollToRow(int row_n, float center_y_ratio)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    const float row_height = (RowHeight > 0.0f) ? RowHeight : ImGui::GetTextLineHeightWithSpacing();
+    // Same target as SetScrollHere() would compute if the row had been submitted
+    float target_y = StartPosY + row_n * row_height - window->Scroll.y;
+    target_y += (row_height - g.Style.ItemSpacing.y) * center_y_ratio + (g.Style.ItemSpacing.y * (center_y_ratio - 0.5f) * 2.0f);
+    ImGui::SetScrollFromPosY(target_y, center_y_ratio);
+}
+
+int ImGuiTreeClipper::FindRow(int node) const
+{
+    for (int n = 0; n < Rows.Size; n++)
+        if (Rows[n].Node == node)
+            return n;
+    return -1;
+}
+
+void ImGuiTreeClipper::Clear()
+{
+    Rows.clear();
+    TempRows.clear();
+    TempChildren.clear();
+    RowsValid = false;
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiWindow
 //-----------------------------------------------------------------------------
@@ -1776,7 +2493,14 @@ ImGuiWindow::ImGuiWindow(const char* name)
     SetWindowPosAllowFlags = SetWindowSizeAllowFlags = SetWindowCollapsedAllowFlags = ImGuiSetCond_Always | ImGuiSetCond_Once | ImGuiSetCond_FirstUseEver | ImGuiSetCond_Appearing;
     SetWindowPosCenterWanted = false;
 
+    HotDataIndex = -1;
+    HitGridCells = ImRect(0.0f, 0.0f, -1.0f, -1.0f);
+    DisplayOrder = 0;
     LastFrameActive = -1;
+    LastTimeActive = -1.0f;
+    MemoryCompacted = false;
+    LayoutSizeFull = LayoutSizeAutoFit = LayoutScrollbarsSize = ImVec2(0.0f, 0.0f);
+    LayoutStableFrames = 0;
     ItemWidthDefault = 0.0f;
     FontWindowScale = 1.0f;
 
@@ -2080,6 +2804,7 @@ ImGuiIO& ImGui::GetIO()
     return GImGui->IO;
 }
 
+// The style may be modified through the returned reference: GetColorU32() checks its packed colors against the style before using them
 ImGuiStyle& ImGui::GetStyle()
 {
     return GImGui->Style;
@@ -2101,6 +2826,105 @@ int ImGui::GetFrameCount()
     return GImGui->FrameCount;
 }
 
+// Apply queued input events to the IO state.
+// With io.InputEventsTrickle, events that would cancel each other out within a single frame (e.g. a button press and release, or a
+// key press followed by typed text) are spread over multiple frames so that every transition is seen by the widgets.
+static void UpdateInputEvents()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+
+    // Characters written directly into the legacy io.InputCharacters[] array are still honored
+    g.InputCharacters.resize(0);
+    for (int n = 0; n < IM_ARRAYSIZE(io.InputCharacters) && io.InputCharacters[n]; n++)
+        g.InputCharacters.push_back(io.InputCharacters[n]);
+    for (int n = 0; n < IM_ARRAYSIZE(g.InputMouseDownEventTime); n++)
+        g.InputMouseDownEventTime[n] = -1.0;
+
+    const bool trickle = io.InputEventsTrickle;
+    bool mouse_moved = false, mouse_wheeled = false, key_changed = false, key_mods_changed = false, text_inputed = false;
+    int mouse_button_changed = 0x00;
+    ImU32 keys_changed[IM_ARRAYSIZE(io.KeysDown) / 32] = { 0 };
+
+    int event_n = 0;
+    for (; event_n < g.InputEventsQueue.Size; event_n++)
+    {
+        const ImGuiInputEvent& e = g.InputEventsQueue[event_n];
+        if (e.Type == ImGuiInputEventType_MousePos)
+        {
+            if (trickle && (mouse_button_changed != 0 || mouse_wheeled || key_changed || text_inputed))
+                break;
+            io.MousePos = e.Pos;
+            mouse_moved = true;
+        }
+        else if (e.Type == ImGuiInputEventType_MouseButton)
+        {
+            const int button = e.Index;
+            if (io.MouseDown[button] == e.Down)
+                continue;
+            if (trickle && ((mouse_button_changed & (1 << button)) || mouse_wheeled))
+                break;
+            io.MouseDown[button] = e.Down;
+            g.InputMouseDownEventTime[button] = e.Time;
+            mouse_button_changed |= (1 << button);
+        }
+        else if (e.Type == ImGuiInputEventType_MouseWheel)
+        {
+            if (trickle && (mouse_moved || mouse_button_changed != 0))
+                break;
+            io.MouseWheel += e.Wheel;
+            mouse_wheeled = true;
+        }
+        else if (e.Type == ImGuiInputEventType_Key)
+        {
+            const int key = e.Index;
+            if (io.KeysDown[key] == e.Down)
+                continue;
+            if (trickle && ((keys_changed[key >> 5] & (1u << (key & 31))) || text_inputed || mouse_button_changed != 0))
+                break;
+            io.KeysDown[key] = e.Down;
+            keys_changed[key >> 5] |= (1u << (key & 31));
+            key_changed = true;
+        }
+        else if (e.Type == ImGuiInputEventType_KeyMods)
+        {
+            const int mods = (io.KeyCtrl ? 1 : 0) | (io.KeyShift ? 2 : 0) | (io.KeyAlt ? 4 : 0) | (io.KeySuper ? 8 : 0);
+            if (mods == e.Index)
+                continue;
+            if (trickle && key_mods_changed)
+                break;
+            io.KeyCtrl = (e.Index & 1) != 0;
+            io.KeyShift = (e.Index & 2) != 0;
+            io.KeyAlt = (e.Index & 4) != 0;
+            io.KeySuper = (e.Index & 8) != 0;
+            key_mods_changed = true;
+        }
+        else if (e.Type == ImGuiInputEventType_Char)
+        {
+            if (trickle && mouse_button_changed != 0)
+                break;
+            g.InputCharacters.push_back(e.Char);
+            text_inputed = true;
+        }
+    }
+
+    // Remove applied events, keep the rest for the next frames
+    if (event_n == g.InputEventsQueue.Size)
+        g.InputEventsQueue.resize(0);
+    else if (event_n > 0)
+    {
+        memmove(g.InputEventsQueue.Data, g.InputEventsQueue.Data + event_n, (size_t)(g.InputEventsQueue.Size - event_n) * sizeof(ImGuiInputEvent));
+        g.InputEventsQueue.resize(g.InputEventsQueue.Size - event_n);
+    }
+
+    // Mirror the start of the character stream in the legacy array, for code reading io.InputCharacters[] directly
+    const int legacy_count = ImMin(g.InputCharacters.Size, IM_ARRAYSIZE(io.InputCharacters) - 1);
+    if (legacy_count > 0)
+        memcpy(io.InputCharacters, g.InputCharacters.Data, legacy_count * sizeof(ImWchar));
+    io.InputCharacters[legacy_count] = 0;
+    g.InputCharacters.push_back(0);
+}
+
 void ImGui::NewFrame()
 {
     ImGuiContext& g = *GImGui;
@@ -2123,12 +2947,28 @@ void ImGui::NewFrame()
         g.Initialized = true;
     }
 
+    g.IO.Fonts->UpdateDynamicGlyphs();
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
 
     g.Time += g.IO.DeltaTime;
     g.FrameCount += 1;
     g.Tooltip[0] = '\0';
+
+    // Update text layout cache
+    ImGuiTextLayoutCache& text_layout_cache = g.TextLayoutCache;
+    text_layout_cache.LastFrameHits = text_layout_cache.FrameHits;
+    text_layout_cache.LastFrameMisses = text_layout_cache.FrameMisses;
+    text_layout_cache.FrameHits = text_layout_cache.FrameMisses = 0;
+    if (text_layout_cache.Capacity != g.IO.TextLayoutCacheSize || text_layout_cache.FontTexID != g.IO.Fonts->TexID || text_layout_cache.FontTexWidth != g.IO.Fonts->TexWidth || text_layout_cache.FontTexHeight != g.IO.Fonts->TexHeight || text_layout_cache.FontTexGeneration != g.IO.Fonts->TexGeneration)
+    {
+        text_layout_cache.Clear();
+        text_layout_cache.Capacity = g.IO.TextLayoutCacheSize;
+        text_layout_cache.FontTexID = g.IO.Fonts->TexID;
+        text_layout_cache.FontTexWidth = g.IO.Fonts->TexWidth;
+        text_layout_cache.FontTexHeight = g.IO.Fonts->TexHeight;
+        text_layout_cache.FontTexGeneration = g.IO.Fonts->TexGeneration;
+    }
     g.OverlayDrawList.Clear();
     g.OverlayDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.OverlayDrawList.PushClipRectFullScreen();
@@ -2137,8 +2977,12 @@ void ImGui::NewFrame()
     g.RenderDrawData.Valid = false;
     g.RenderDrawData.CmdLists = NULL;
     g.RenderDrawData.CmdListsCount = g.RenderDrawData.TotalVtxCount = g.RenderDrawData.TotalIdxCount = 0;
+    g.RenderDrawData.VtxArena = NULL;
+    g.RenderDrawData.IdxArena = NULL;
+    g.RenderDrawData.VtxOffsets = g.RenderDrawData.IdxOffsets = NULL;
 
     // Update inputs state
+    UpdateInputEvents();
     if (g.IO.MousePos.x < 0 && g.IO.MousePos.y < 0)
         g.IO.MousePos = ImVec2(-9999.0f, -9999.0f);
     if ((g.IO.MousePos.x < 0 && g.IO.MousePos.y < 0) || (g.IO.MousePosPrev.x < 0 && g.IO.MousePosPrev.y < 0))   // if mouse just appeared or disappeared (negative coordinate) we cancel out movement in MouseDelta
@@ -2155,15 +2999,20 @@ void ImGui::NewFrame()
         g.IO.MouseDoubleClicked[i] = false;
         if (g.IO.MouseClicked[i])
         {
-            if (g.Time - g.IO.MouseClickedTime[i] < g.IO.MouseDoubleClickTime)
+            // Prefer the event timestamps when the back-end provides them, so double-clicks are still detected at low frame-rates
+            const double event_time = g.InputMouseDownEventTime[i];
+            const double click_elapsed = (event_time >= 0.0 && g.InputMouseClickedEventTime[i] >= 0.0) ? event_time - g.InputMouseClickedEventTime[i] : g.Time - g.IO.MouseClickedTime[i];
+            if (click_elapsed < g.IO.MouseDoubleClickTime)
             {
                 if (ImLengthSqr(g.IO.MousePos - g.IO.MouseClickedPos[i]) < g.IO.MouseDoubleClickMaxDist * g.IO.MouseDoubleClickMaxDist)
                     g.IO.MouseDoubleClicked[i] = true;
                 g.IO.MouseClickedTime[i] = -FLT_MAX;    // so the third click isn't turned into a double-click
+                g.InputMouseClickedEventTime[i] = -1.0;
             }
             else
             {
                 g.IO.MouseClickedTime[i] = g.Time;
+                g.InputMouseClickedEventTime[i] = event_time;
             }
             g.IO.MouseClickedPos[i] = g.IO.MousePos;
             g.IO.MouseDragMaxDistanceSqr[i] = 0.0f;
@@ -2231,6 +3080,7 @@ void ImGui::NewFrame()
     }
 
     // Find the window we are hovering. Child windows can extend beyond the limit of their parent so we need to derive HoveredRootWindow from HoveredWindow
+    UpdateWindowsHitGridLayout();
     g.HoveredWindow = g.MovedWindow ? g.MovedWindow : FindHoveredWindow(g.IO.MousePos, false);
     if (g.HoveredWindow && (g.HoveredWindow->Flags & ImGuiWindowFlags_ChildWindow))
         g.HoveredRootWindow = g.HoveredWindow->RootWindow;
@@ -2313,14 +3163,48 @@ void ImGui::NewFrame()
         g.FocusedWindow->FocusIdxTabRequestNext = 0;
 
     // Mark all windows as not visible
-    for (int i = 0; i != g.Windows.Size; i++)
+    // Windows which were neither active this frame nor the previous one are already in that state and are skipped without touching them.
+    for (int i = 0; i != g.WindowsHotData.Size; i++)
     {
-        ImGuiWindow* window = g.Windows[i];
-        window->WasActive = window->Active;
-        window->Active = false;
+        ImGuiWindowHotData& hot = g.WindowsHotData[i];
+        if (!hot.Active && !hot.WasActive)
+            continue;
+        ImGuiWindow* window = hot.Window;
+        if (!hot.Active)
+        {
+            UpdateWindowHitGrid(window, false);
+            if (window->DrawList->UseBuffersPool)
+                window->DrawList->Clear();  // Give buffers back to the pool, they would be cleared on the next Begin() anyway
+        }
+        window->WasActive = hot.WasActive = hot.Active;
+        window->Active = hot.Active = false;
         window->Accessed = false;
     }
 
+    // Release memory of windows which haven't been submitted for a while. Windows still referenced by the current interaction are left alone.
+    if (g.IO.WindowsCompactTimer >= 0.0f || g.IO.WindowsDestroyTimer >= 0.0f)
+        for (int i = 0; i < g.WindowsHotData.Size; i++)
+        {
+            ImGuiWindowHotData& hot = g.WindowsHotData[i];
+            if (hot.Window == NULL || hot.WasActive || hot.Window == g.ActiveIdWindow || hot.Window == g.MovedWindow)
+                continue;
+            const float inactive_time = (float)g.Time - hot.LastTimeActive;
+            if (g.IO.WindowsDestroyTimer >= 0.0f && inactive_time >= g.IO.WindowsDestroyTimer)
+            {
+                bool in_popup_stack = false;
+                for (int n = 0; n < g.OpenPopupStack.Size && !in_popup_stack; n++)
+                    in_popup_stack = (g.OpenPopupStack[n].Window == hot.Window || g.OpenPopupStack[n].ParentWindow == hot.Window);
+                if (!in_popup_stack)
+                {
+                    DestroyWindow(hot.Window);
+                    continue;
+                }
+            }
+            if (g.IO.WindowsCompactTimer >= 0.0f && inactive_time >= g.IO.WindowsCompactTimer && !hot.MemoryCompacted)
+                CompactWindowMemory(hot.Window);
+        }
+    g.DrawBuffersPool.GarbageCollect(g.FrameCount, g.IO.DrawBuffersPoolDecayFrames);
+
     // Closing the focused window restore focus to the first active root window in descending z-order
     if (g.FocusedWindow && !g.FocusedWindow->WasActive)
         for (int i = g.Windows.Size-1; i >= 0; i--)
@@ -2363,6 +3247,7 @@ void ImGui::Shutdown()
     }
     g.Windows.clear();
     g.WindowsSortBuffer.clear();
+    g.WindowsHitGrid.Clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.FocusedWindow = NULL;
@@ -2375,14 +3260,42 @@ void ImGui::Shutdown()
     g.Settings.clear();
     g.ColorModifiers.clear();
     g.StyleModifiers.clear();
+    g.StyleSnapshotBackups.clear();
     g.FontStack.clear();
     g.OpenPopupStack.clear();
     g.CurrentPopupStack.clear();
+    g.WindowsById.Clear();
+    g.WindowsHotData.clear();
+    g.WindowsHotDataFreeSlots.clear();
+    g.InputEventsQueue.clear();
+    g.InputCharacters.clear();
     g.SetNextWindowSizeConstraintCallback = NULL;
     g.SetNextWindowSizeConstraintCallbackUserData = NULL;
     for (int i = 0; i < IM_ARRAYSIZE(g.RenderDrawLists); i++)
         g.RenderDrawLists[i].clear();
+    g.RenderVtxArena.clear();
+    g.RenderIdxArena.clear();
+    g.RenderVtxOffsets.clear();
+    g.RenderIdxOffsets.clear();
     g.OverlayDrawList.ClearFreeMemory();
+    g.MouseCursorDrawList.ClearFreeMemory();
+    g.MouseCursorDrawListPos.clear();
+    g.MouseCursorDrawListCursor = ImGuiMouseCursor_None;
+    g.DrawBuffersPool.Clear();
+    g.TextLayoutCache.Clear();
+    for (int i = 0; i < g.ItemsIndices.Size; i++)
+    {
+        g.ItemsIndices[i]->~ImGuiItemsIndex();
+        ImGui::MemFree(g.ItemsIndices[i]);
+    }
+    g.ItemsIndices.clear();
+    for (int i = 0; i < g.Tables.Size; i++)
+    {
+        g.Tables[i]->~ImGuiTable();
+        ImGui::MemFree(g.Tables[i]);
+    }
+    g.Tables.clear();
+    g.CurrentTable = NULL;
     g.ColorEditModeStorage.Clear();
     if (g.PrivateClipboard)
     {
@@ -2562,6 +3475,8 @@ static void AddWindowToSortedBuffer(ImVector<ImGuiWindow*>& out_sorted_windows,
 
 static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDrawList* draw_list)
 {
+    if (draw_list->UseBuffersPool)
+        GImGui->DrawBuffersPool.UsedBytes += draw_list->VtxBuffer.Capacity * (int)sizeof(ImDrawVert) + draw_list->IdxBuffer.Capacity * (int)sizeof(ImDrawIdx);
     if (draw_list->CmdBuffer.empty())
         return;
 
@@ -2585,7 +3500,205 @@ static void AddDrawListToRenderList(ImVector<ImDrawList*>& out_render_list, ImDr
     
     out_render_list.push_back(draw_list);
     GImGui->IO.MetricsRenderVertices += draw_list->VtxBuffer.Size;
-    GImGui->IO.MetricsRenderIndices += draw_list->IdxBuffer.Size;
+    GImGui->IO.MetricsRenderIndices += draw_list->GetIdxCount();
+}
+
+// Discard the draw commands which can't be visible: clipped out of the display, or behind the opaque background of a window drawn after them.
+// Then discard the draw lists left without commands, so their vertices aren't uploaded by the renderer. Commands with a user callback are always kept.
+// The clipping rectangles of the remaining commands are trimmed to the display.
+static void CullRenderDrawLists(ImVector<ImDrawList*>& draw_lists)
+{
+    ImGuiContext& g = *GImGui;
+    const ImRect display_rect(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
+    ImRect occluders[8];    // Largest opaque rectangles of the draw lists processed so far, which are drawn on top of the current one
+    int occluders_count = 0;
+    int lists_kept = draw_lists.Size;
+    for (int list_n = draw_lists.Size - 1; list_n >= 0; list_n--)
+    {
+        ImDrawList* draw_list = draw_lists[list_n];
+        const int idx_count = draw_list->GetIdxCount();
+        const bool can_remove_cmds = draw_list->IdxSpans.empty(); // Indices of merged channels aren't contiguous, only cull the whole list
+        ImDrawIdx* idx_read = draw_list->IdxBuffer.Data;
+        ImDrawIdx* idx_write = draw_list->IdxBuffer.Data;
+        int cmds_kept = 0;
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+            bool visible = (cmd.UserCallback != NULL);
+            if (!visible && cmd.ElemCount > 0)
+            {
+                ImRect clip_rect(cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w);
+                clip_rect.Clip(display_rect);
+                visible = (clip_rect.Min.x < clip_rect.Max.x && clip_rect.Min.y < clip_rect.Max.y);
+                if (visible)
+                    cmd.ClipRect = ImVec4(clip_rect.Min.x, clip_rect.Min.y, clip_rect.Max.x, clip_rect.Max.y);
+
+                // Root windows draw with a clipping rectangle covering the display, so when the command may be behind an opaque rectangle we use the bounds of its vertices
+                bool may_be_occluded = false;
+                for (int n = 0; n < occluders_count && visible && !may_be_occluded; n++)
+                    may_be_occluded = occluders[n].Overlaps(clip_rect);
+                if (may_be_occluded && can_remove_cmds)
+                {
+                    ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                    const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
+                    for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                        bounds.Add(vtx_buffer[idx_read[i]].pos);
+                    bounds.Clip(clip_rect);
+                    for (int n = 0; n < occluders_count && visible; n++)
+                        if (bounds.Min.x >= occluders[n].Min.x && bounds.Min.y >= occluders[n].Min.y && bounds.Max.x <= occluders[n].Max.x && bounds.Max.y <= occluders[n].Max.y)
+                            visible = false;
+                }
+            }
+            if (!can_remove_cmds)
+            {
+                cmds_kept += visible ? 1 : 0;
+                continue;
+            }
+            if (visible)
+            {
+                if (idx_write != idx_read)
+                    memmove(idx_write, idx_read, cmd.ElemCount * sizeof(ImDrawIdx));
+                idx_write += cmd.ElemCount;
+                if (cmds_kept != cmd_n)
+                    draw_list->CmdBuffer[cmds_kept] = cmd;
+                cmds_kept++;
+            }
+            idx_read += cmd.ElemCount;
+        }
+
+        if (cmds_kept == 0)
+        {
+            // Nothing visible, don't output the list at all
+            g.IO.MetricsRenderVertices -= draw_list->VtxBuffer.Size;
+            g.IO.MetricsRenderIndices -= idx_count;
+            g.IO.MetricsRenderCulledVertices += draw_list->VtxBuffer.Size;
+            g.IO.MetricsRenderCulledIndices += idx_count;
+            draw_lists[list_n] = NULL;
+            lists_kept--;
+            continue;
+        }
+        if (can_remove_cmds && cmds_kept < draw_list->CmdBuffer.Size)
+        {
+            const int idx_culled = idx_count - (int)(idx_write - draw_list->IdxBuffer.Data);
+            draw_list->CmdBuffer.resize(cmds_kept);
+            draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size - idx_culled);
+            draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+            g.IO.MetricsRenderIndices -= idx_culled;
+            g.IO.MetricsRenderCulledIndices += idx_culled;
+        }
+
+        // This list hides what is behind its opaque rectangle. Keep the largest ones.
+        ImRect opaque_rect(draw_list->_OpaqueRect.x, draw_list->_OpaqueRect.y, draw_list->_OpaqueRect.z, draw_list->_OpaqueRect.w);
+        opaque_rect.Expand(-1.0f);  // Anti-aliased edges of the background aren't fully opaque
+        opaque_rect.Clip(display_rect);
+        if (opaque_rect.Min.x < opaque_rect.Max.x && opaque_rect.Min.y < opaque_rect.Max.y)
+        {
+            int dst_n = occluders_count;
+            if (occluders_count == IM_ARRAYSIZE(occluders))
+            {
+                dst_n = 0;
+                for (int n = 1; n < occluders_count; n++)
+                    if (occluders[n].GetWidth() * occluders[n].GetHeight() < occluders[dst_n].GetWidth() * occluders[dst_n].GetHeight())
+                        dst_n = n;
+                if (occluders[dst_n].GetWidth() * occluders[dst_n].GetHeight() >= opaque_rect.GetWidth() * opaque_rect.GetHeight())
+                    dst_n = -1;
+            }
+            else
+            {
+                occluders_count++;
+            }
+            if (dst_n >= 0)
+                occluders[dst_n] = opaque_rect;
+        }
+    }
+
+    if (lists_kept < draw_lists.Size)
+    {
+        int dst_n = 0;
+        for (int n = 0; n < draw_lists.Size; n++)
+            if (draw_lists[n] != NULL)
+                draw_lists[dst_n++] = draw_lists[n];
+        draw_lists.resize(dst_n);
+    }
+}
+
+// Copy the vertices and indices of all draw lists into the frame arenas (io.DrawDataUseArenas), so renderers can upload them at once
+static void SetupDrawDataArenas(ImDrawData* draw_data)
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.IO.DrawDataUseArenas)
+    {
+        draw_data->VtxArena = NULL;
+        draw_data->IdxArena = NULL;
+        draw_data->VtxOffsets = draw_data->IdxOffsets = NULL;
+        return;
+    }
+
+    g.RenderVtxArena.resize(draw_data->TotalVtxCount);
+    g.RenderIdxArena.resize(draw_data->TotalIdxCount);
+    g.RenderVtxOffsets.resize(draw_data->CmdListsCount);
+    g.RenderIdxOffsets.resize(draw_data->CmdListsCount);
+    int vtx_offset = 0, idx_offset = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        g.RenderVtxOffsets[n] = vtx_offset;
+        g.RenderIdxOffsets[n] = idx_offset;
+        if (draw_list->VtxBuffer.Size > 0)
+            memcpy(g.RenderVtxArena.Data + vtx_offset, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        vtx_offset += draw_list->VtxBuffer.Size;
+        for (int span_n = 0; span_n < draw_list->IdxSpans.Size; span_n++)
+        {
+            const ImDrawIdxSpan& span = draw_list->IdxSpans[span_n];
+            memcpy(g.RenderIdxArena.Data + idx_offset, span.IdxData, (size_t)span.IdxCount * sizeof(ImDrawIdx));
+            idx_offset += span.IdxCount;
+        }
+        if (draw_list->IdxBuffer.Size > 0)
+            memcpy(g.RenderIdxArena.Data + idx_offset, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        idx_offset += draw_list->IdxBuffer.Size;
+    }
+    IM_ASSERT(vtx_offset == draw_data->TotalVtxCount && idx_offset == draw_data->TotalIdxCount);
+    draw_data->VtxArena = g.RenderVtxArena.Data;
+    draw_data->IdxArena = g.RenderIdxArena.Data;
+    draw_data->VtxOffsets = g.RenderVtxOffsets.Data;
+    draw_data->IdxOffsets = g.RenderIdxOffsets.Data;
+}
+
+// The cursor quads are built relative to the mouse position when the cursor shape or the font texture changes, then only translated
+static void UpdateMouseCursorDrawList()
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawList& draw_list = g.MouseCursorDrawList;
+    const ImTextureID tex_id = g.IO.Fonts->TexID;
+    if (g.MouseCursorDrawListCursor != g.MouseCursor || g.MouseCursorDrawListTexID != tex_id || g.MouseCursorDrawListTexGeneration != g.IO.Fonts->TexGeneration || draw_list.VtxBuffer.Size != g.MouseCursorDrawListPos.Size)
+    {
+        const ImGuiMouseCursorData& cursor_data = g.MouseCursorData[g.MouseCursor];
+        const ImVec2 pos = ImVec2(-cursor_data.HotOffset.x, -cursor_data.HotOffset.y);
+        const ImVec2 size = cursor_data.Size;
+        draw_list.Clear();
+        draw_list.PushClipRectFullScreen();
+        draw_list.PushTextureID(tex_id);
+        draw_list.AddImage(tex_id, pos+ImVec2(1,0), pos+ImVec2(1,0) + size, cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], IM_COL32(0,0,0,48));        // Shadow
+        draw_list.AddImage(tex_id, pos+ImVec2(2,0), pos+ImVec2(2,0) + size, cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], IM_COL32(0,0,0,48));        // Shadow
+        draw_list.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], IM_COL32(0,0,0,255));       // Black border
+        draw_list.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[0], cursor_data.TexUvMax[0], IM_COL32(255,255,255,255)); // White fill
+        g.MouseCursorDrawListPos.resize(draw_list.VtxBuffer.Size);
+        for (int i = 0; i < draw_list.VtxBuffer.Size; i++)
+            g.MouseCursorDrawListPos[i] = draw_list.VtxBuffer[i].pos;
+        g.MouseCursorDrawListCursor = g.MouseCursor;
+        g.MouseCursorDrawListTexID = tex_id;
+        g.MouseCursorDrawListTexGeneration = g.IO.Fonts->TexGeneration;
+        g.MouseCursorDrawListMousePos = ImVec2(0.0f, 0.0f);
+    }
+
+    if (g.MouseCursorDrawListMousePos.x != g.IO.MousePos.x || g.MouseCursorDrawListMousePos.y != g.IO.MousePos.y)
+    {
+        const ImVec2 mouse_pos = g.IO.MousePos;
+        ImDrawVert* vtx = draw_list.VtxBuffer.Data;
+        for (int i = 0; i < draw_list.VtxBuffer.Size; i++)
+            vtx[i].pos = g.MouseCursorDrawListPos[i] + mouse_pos;
+        g.MouseCursorDrawListMousePos = mouse_pos;
+    }
 }
 
 static void AddWindowToRenderList(ImVector<ImDrawList*>& out_render_list, ImGuiWindow* window)
@@ -2642,7 +3755,7 @@ void ImGui::EndFrame()
     // Hide implicit "Debug" window if it hasn't been used
     IM_ASSERT(g.CurrentWindowStack.Size == 1);    // Mismatched Begin()/End() calls
     if (g.CurrentWindow && !g.CurrentWindow->Accessed)
-        g.CurrentWindow->Active = false;
+        g.CurrentWindow->Active = g.WindowsHotData[g.CurrentWindow->HotDataIndex].Active = false;
     ImGui::End();
 
     // Click to focus window and start moving (after we're done with all our widgets)
@@ -2681,10 +3794,16 @@ void ImGui::EndFrame()
     }
     IM_ASSERT(g.Windows.Size == g.WindowsSortBuffer.Size);  // we done something wrong
     g.Windows.swap(g.WindowsSortBuffer);
+    for (int i = 0; i != g.Windows.Size; i++)
+    {
+        g.Windows[i]->DisplayOrder = i;
+        g.WindowsHotData[g.Windows[i]->HotDataIndex].DisplayOrder = i;
+    }
 
     // Clear Input data for next frame
     g.IO.MouseWheel = 0.0f;
     memset(g.IO.InputCharacters, 0, sizeof(g.IO.InputCharacters));
+    g.InputCharacters.resize(0);
 
     g.FrameCountEnded = g.FrameCount;
 }
@@ -2704,6 +3823,8 @@ void ImGui::Render()
     {
         // Gather windows to render
         g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsActiveWindows = 0;
+        g.IO.MetricsRenderCulledVertices = g.IO.MetricsRenderCulledIndices = 0;
+        g.DrawBuffersPool.UsedBytes = 0;
         for (int i = 0; i < IM_ARRAYSIZE(g.RenderDrawLists); i++)
             g.RenderDrawLists[i].resize(0);
         for (int i = 0; i != g.Windows.Size; i++)
@@ -2736,30 +3857,26 @@ void ImGui::Render()
             memcpy(&g.RenderDrawLists[0][n], &layer[0], layer.Size * sizeof(ImDrawList*));
             n += layer.Size;
         }
+        CullRenderDrawLists(g.RenderDrawLists[0]);
 
-        // Draw software mouse cursor if requested
-        if (g.IO.MouseDrawCursor)
-        {
-            const ImGuiMouseCursorData& cursor_data = g.MouseCursorData[g.MouseCursor];
-            const ImVec2 pos = g.IO.MousePos - cursor_data.HotOffset;
-            const ImVec2 size = cursor_data.Size;
-            const ImTextureID tex_id = g.IO.Fonts->TexID;
-            g.OverlayDrawList.PushTextureID(tex_id);
-            g.OverlayDrawList.AddImage(tex_id, pos+ImVec2(1,0), pos+ImVec2(1,0) + size, cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], IM_COL32(0,0,0,48));        // Shadow
-            g.OverlayDrawList.AddImage(tex_id, pos+ImVec2(2,0), pos+ImVec2(2,0) + size, cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], IM_COL32(0,0,0,48));        // Shadow
-            g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[1], cursor_data.TexUvMax[1], IM_COL32(0,0,0,255));       // Black border
-            g.OverlayDrawList.AddImage(tex_id, pos,             pos + size,             cursor_data.TexUvMin[0], cursor_data.TexUvMax[0], IM_COL32(255,255,255,255)); // White fill
-            g.OverlayDrawList.PopTextureID();
-        }
         if (!g.OverlayDrawList.VtxBuffer.empty())
             AddDrawListToRenderList(g.RenderDrawLists[0], &g.OverlayDrawList);
 
+        // Draw software mouse cursor if requested
+        if (g.IO.MouseDrawCursor && g.MouseCursor != ImGuiMouseCursor_None)
+        {
+            UpdateMouseCursorDrawList();
+            AddDrawListToRenderList(g.RenderDrawLists[0], &g.MouseCursorDrawList);
+        }
+
         // Setup draw data
         g.RenderDrawData.Valid = true;
         g.RenderDrawData.CmdLists = (g.RenderDrawLists[0].Size > 0) ? &g.RenderDrawLists[0][0] : NULL;
         g.RenderDrawData.CmdListsCount = g.RenderDrawLists[0].Size;
         g.RenderDrawData.TotalVtxCount = g.IO.MetricsRenderVertices;
         g.RenderDrawData.TotalIdxCount = g.IO.MetricsRenderIndices;
+        SetupDrawDataArenas(&g.RenderDrawData);
+        g.IO.MetricsDrawBuffersPoolBytes = g.DrawBuffersPool.UsedBytes + g.DrawBuffersPool.FreeBytes;
 
         // Render. If user hasn't set a callback then they may retrieve the draw data via GetDrawData()
         if (g.RenderDrawData.CmdListsCount > 0 && g.IO.RenderDrawListsFn != NULL)
@@ -2849,6 +3966,298 @@ static void LogRenderedText(const ImVec2& ref_pos, const char* text, const char*
     }
 }
 
+//-----------------------------------------------------------------------------
+// Text layout cache
+//-----------------------------------------------------------------------------
+// Short texts submitted every frame (labels, table cells) are hashed and looked up in a LRU cache of layouts.
+// A cached layout stores the measured size and glyph quads, so measuring is a lookup and rendering is a copy + translation.
+//-----------------------------------------------------------------------------
+
+#define IMGUI_TEXT_LAYOUT_CACHE_MAX_LEN     128     // Longer text is unlikely to be repeated, and benefits from the line clipping done by ImFont::RenderText()
+
+void ImGuiTextLayoutCache::Clear()
+{
+    Layouts.clear();
+    TextData.clear();
+    QuadsData.clear();
+    TextDataUsed = QuadsDataUsed = 0;
+    Buckets.clear();
+    TempDrawList.ClearFreeMemory();
+    LruHead = LruTail = LastUsedIdx = -1;
+}
+
+static ImVec2 CalcTextSizeNoCache(ImFont* font, float font_size, const char* text, const char* text_end, float wrap_width)
+{
+    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_end, NULL);
+
+    // Cancel out character spacing for the last character of a line (it is baked into glyph->XAdvance field)
+    const float font_scale = font_size / font->FontSize;
+    const float character_spacing_x = 1.0f * font_scale;
+    if (text_size.x > 0.0f)
+        text_size.x -= character_spacing_x;
+    text_size.x = (float)(int)(text_size.x + 0.95f);
+
+    return text_size;
+}
+
+static void TextLayoutCacheUnlink(ImGuiTextLayoutCache& cache, int idx)
+{
+    ImGuiTextLayout& layout = cache.Layouts[idx];
+    if (layout.LruPrev != -1) cache.Layouts[layout.LruPrev].LruNext = layout.LruNext; else cache.LruHead = layout.LruNext;
+    if (layout.LruNext != -1) cache.Layouts[layout.LruNext].LruPrev = layout.LruPrev; else cache.LruTail = layout.LruPrev;
+    layout.LruPrev = layout.LruNext = -1;
+}
+
+static void TextLayoutCacheLinkFront(ImGuiTextLayoutCache& cache, int idx)
+{
+    ImGuiTextLayout& layout = cache.Layouts[idx];
+    layout.LruPrev = -1;
+    layout.LruNext = cache.LruHead;
+    if (cache.LruHead != -1)
+        cache.Layouts[cache.LruHead].LruPrev = idx;
+    cache.LruHead = idx;
+    if (cache.LruTail == -1)
+        cache.LruTail = idx;
+}
+
+// Move the text and quads of all layouts to the front of TextData/QuadsData, dropping the data of recycled layouts
+static void TextLayoutCacheCompact(ImGuiTextLayoutCache& cache)
+{
+    ImVector<char> text_data;
+    ImVector<ImGuiTextLayoutQuad> quads_data;
+    text_data.reserve(cache.TextDataUsed);
+    quads_data.reserve(cache.QuadsDataUsed);
+    for (int i = 0; i < cache.Layouts.Size; i++)
+    {
+        ImGuiTextLayout& layout = cache.Layouts[i];
+        text_data.resize(text_data.Size + layout.TextLen);
+        memcpy(text_data.Data + text_data.Size - layout.TextLen, cache.TextData.Data + layout.TextOffset, (size_t)layout.TextLen);
+        layout.TextOffset = text_data.Size - layout.TextLen;
+        quads_data.resize(quads_data.Size + layout.QuadsCount);
+        memcpy(quads_data.Data + quads_data.Size - layout.QuadsCount, cache.QuadsData.Data + layout.QuadsOffset, (size_t)layout.QuadsCount * sizeof(ImGuiTextLayoutQuad));
+        layout.QuadsOffset = quads_data.Size - layout.QuadsCount;
+    }
+    cache.TextData.swap(text_data);
+    cache.QuadsData.swap(quads_data);
+}
+
+static bool TextLayoutMatch(const ImGuiTextLayoutCache& cache, const ImGuiTextLayout& layout, const ImFont* font, float font_size, float wrap_width, const char* text, int text_len)
+{
+    return layout.Font == font && layout.FontSize == font_size && layout.WrapWidth == wrap_width && layout.TextLen == text_len && memcmp(cache.TextData.Data + layout.TextOffset, text, (size_t)text_len) == 0;
+}
+
+// Hash used by the text layout cache. Reads 4 bytes at a time, which makes it several times faster than ImHash() on labels.
+static ImU32 TextLayoutHash(const void* data, int data_size, ImU32 seed)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    ImU32 h = seed ^ (ImU32)data_size;
+    int n = 0;
+    for (; n + 4 <= data_size; n += 4)
+    {
+        ImU32 k;
+        memcpy(&k, bytes + n, 4);
+        k *= 0xCC9E2D51; k = (k << 15) | (k >> 17); k *= 0x1B873593;
+        h ^= k; h = (h << 13) | (h >> 19); h = h * 5 + 0xE6546B64;
+    }
+    for (; n < data_size; n++)
+        h = (h ^ bytes[n]) * 0x01000193;
+    h ^= h >> 16; h *= 0x85EBCA6B; h ^= h >> 13;
+    return h;
+}
+
+// Return cached layout for text with current font, or NULL if the text is not eligible for caching
+static const ImGuiTextLayout* GetTextLayout(const char* text, const char* text_end, float wrap_width)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextLayoutCache& cache = g.TextLayoutCache;
+    const int text_len = (int)(text_end - text);
+    if (cache.Capacity <= 0 || text_len <= 0 || text_len > IMGUI_TEXT_LAYOUT_CACHE_MAX_LEN)
+        return NULL;
+
+    ImFont* font = g.Font;
+    const float font_size = g.FontSize;
+    if (cache.LastUsedIdx != -1 && TextLayoutMatch(cache, cache.Layouts[cache.LastUsedIdx], font, font_size, wrap_width, text, text_len))
+    {
+        cache.FrameHits++;
+        return &cache.Layouts[cache.LastUsedIdx];
+    }
+
+    struct { const ImFont* font; float font_size; float wrap_width; } key_params = { font, font_size, wrap_width };
+    const ImGuiID key = TextLayoutHash(text, text_len, TextLayoutHash(&key_params, (int)sizeof(key_params), 0));
+    if (cache.Buckets.empty())
+    {
+        cache.Buckets.resize(ImUpperPowerOfTwo(cache.Capacity));
+        memset(cache.Buckets.Data, 0xFF, (size_t)cache.Buckets.Size * sizeof(int));
+    }
+    int* bucket = &cache.Buckets[key & (cache.Buckets.Size - 1)];
+    for (int idx = *bucket; idx != -1; idx = cache.Layouts[idx].HashNext)
+    {
+        if (cache.Layouts[idx].Key != key || !TextLayoutMatch(cache, cache.Layouts[idx], font, font_size, wrap_width, text, text_len))
+            continue;
+        cache.FrameHits++;
+        if (cache.LruHead != idx)
+        {
+            TextLayoutCacheUnlink(cache, idx);
+            TextLayoutCacheLinkFront(cache, idx);
+        }
+        cache.LastUsedIdx = idx;
+        return &cache.Layouts[idx];
+    }
+    cache.FrameMisses++;
+
+    // Add a new layout, or recycle the least recently used one
+    int idx;
+    if (cache.Layouts.Size < cache.Capacity)
+    {
+        idx = cache.Layouts.Size;
+        cache.Layouts.resize(cache.Layouts.Size + 1);
+    }
+    else
+    {
+        idx = cache.LruTail;
+        TextLayoutCacheUnlink(cache, idx);
+        int* p_idx = &cache.Buckets[cache.Layouts[idx].Key & (cache.Buckets.Size - 1)];
+        while (*p_idx != idx)
+            p_idx = &cache.Layouts[*p_idx].HashNext;
+        *p_idx = cache.Layouts[idx].HashNext;
+        cache.TextDataUsed -= cache.Layouts[idx].TextLen;
+        cache.QuadsDataUsed -= cache.Layouts[idx].QuadsCount;
+    }
+    TextLayoutCacheLinkFront(cache, idx);
+    cache.Layouts[idx].HashNext = *bucket;
+    *bucket = idx;
+    cache.LastUsedIdx = idx;
+
+    ImGuiTextLayout& layout = cache.Layouts[idx];
+    layout.TextOffset = layout.TextLen = layout.QuadsOffset = layout.QuadsCount = 0;
+    if (cache.TextData.Size > cache.TextDataUsed * 2 || cache.QuadsData.Size > cache.QuadsDataUsed * 2)
+        TextLayoutCacheCompact(cache);
+    layout.Key = key;
+    layout.Font = font;
+    layout.FontSize = font_size;
+    layout.WrapWidth = wrap_width;
+    layout.TextOffset = cache.TextData.Size;
+    layout.TextLen = text_len;
+    cache.TextData.resize(cache.TextData.Size + text_len);
+    memcpy(cache.TextData.Data + layout.TextOffset, text, (size_t)text_len);
+    cache.TextDataUsed += text_len;
+    const ImVec2 size = CalcTextSizeNoCache(font, font_size, text, text_end, wrap_width);
+    layout.SizeX = size.x;
+    layout.SizeY = size.y;
+
+    // Render the glyphs once at the origin without clipping, and keep the quads
+    ImDrawList& draw_list = cache.TempDrawList;
+    draw_list.Clear();
+    draw_list.AddDrawCmd();
+    font->RenderText(&draw_list, font_size, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, ImVec4(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX), text, text_end, wrap_width, false);
+    layout.QuadsOffset = cache.QuadsData.Size;
+    layout.QuadsCount = draw_list.VtxBuffer.Size / 4;
+    cache.QuadsData.resize(cache.QuadsData.Size + layout.QuadsCount);
+    cache.QuadsDataUsed += layout.QuadsCount;
+    for (int n = 0; n < layout.QuadsCount; n++)
+    {
+        const ImDrawVert* v = &draw_list.VtxBuffer[n * 4];
+        const ImVec2 pos0 = v[0].pos, uv0 = v[0].uv, pos2 = v[2].pos, uv2 = v[2].uv;
+        ImGuiTextLayoutQuad& quad = cache.QuadsData[layout.QuadsOffset + n];
+        quad.X0 = pos0.x; quad.Y0 = pos0.y; quad.U0 = uv0.x; quad.V0 = uv0.y;
+        quad.X1 = pos2.x; quad.Y1 = pos2.y; quad.U1 = uv2.x; quad.V1 = uv2.y;
+    }
+    return &layout;
+}
+
+// Same output as ImFont::RenderText() from a cached layout
+static void RenderTextLayout(ImDrawList* draw_list, const ImGuiTextLayout* layout, ImVec2 pos, ImU32 col, const ImVec4* cpu_fine_clip_rect)
+{
+    ImGuiContext& g = *GImGui;
+    if ((col & IM_COL32_A_MASK) == 0 || layout->QuadsCount == 0)
+        return;
+
+    ImVec4 clip_rect = draw_list->_ClipRectStack.back();
+    if (cpu_fine_clip_rect)
+    {
+        clip_rect.x = ImMax(clip_rect.x, cpu_fine_clip_rect->x);
+        clip_rect.y = ImMax(clip_rect.y, cpu_fine_clip_rect->y);
+        clip_rect.z = ImMin(clip_rect.z, cpu_fine_clip_rect->z);
+        clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect->w);
+    }
+
+    // Align to be pixel perfect (font DisplayOffset is already baked in the quads)
+    pos.x = (float)(int)pos.x;
+    pos.y = (float)(int)pos.y;
+    if (pos.y > clip_rect.w)
+        return;
+
+    const int idx_expected_size = draw_list->IdxBuffer.Size + layout->QuadsCount * 6;
+    draw_list->PrimReserve(layout->QuadsCount * 6, layout->QuadsCount * 4);
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+    const ImGuiTextLayoutQuad* quads = g.TextLayoutCache.QuadsData.Data + layout->QuadsOffset;
+    for (const ImGuiTextLayoutQuad* quad = quads; quad != quads + layout->QuadsCount; quad++)
+    {
+        float x1 = pos.x + quad->X0, y1 = pos.y + quad->Y0, x2 = pos.x + quad->X1, y2 = pos.y + quad->Y1;
+        if (x1 > clip_rect.z || x2 < clip_rect.x || y1 > clip_rect.w || y2 < clip_rect.y)
+            continue;
+        float u1 = quad->U0, v1 = quad->V0, u2 = quad->U1, v2 = quad->V1;
+
+        // CPU side clipping, see ImFont::RenderText()
+        if (cpu_fine_clip_rect)
+        {
+            if (x1 < clip_rect.x)
+            {
+                u1 = u1 + (1.0f - (x2 - clip_rect.x) / (x2 - x1)) * (u2 - u1);
+                x1 = clip_rect.x;
+            }
+            if (y1 < clip_rect.y)
+            {
+                v1 = v1 + (1.0f - (y2 - clip_rect.y) / (y2 - y1)) * (v2 - v1);
+                y1 = clip_rect.y;
+            }
+            if (x2 > clip_rect.z)
+            {
+                u2 = u1 + ((clip_rect.z - x1) / (x2 - x1)) * (u2 - u1);
+                x2 = clip_rect.z;
+            }
+            if (y2 > clip_rect.w)
+            {
+                v2 = v1 + ((clip_rect.w - y1) / (y2 - y1)) * (v2 - v1);
+                y2 = clip_rect.w;
+            }
+            if (y1 >= y2)
+                continue;
+        }
+
+        idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+        idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+        vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = col; vtx_write[0].uv = ImVec2(u1, v1);
+        vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = col; vtx_write[1].uv = ImVec2(u2, v1);
+        vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = col; vtx_write[2].uv = ImVec2(u2, v2);
+        vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = col; vtx_write[3].uv = ImVec2(u1, v2);
+        vtx_write += 4;
+        vtx_current_idx += 4;
+        idx_write += 6;
+    }
+
+    // Give back unused vertices
+    draw_list->VtxBuffer.resize((int)(vtx_write - draw_list->VtxBuffer.Data));
+    draw_list->IdxBuffer.resize((int)(idx_write - draw_list->IdxBuffer.Data));
+    draw_list->CmdBuffer[draw_list->CmdBuffer.Size-1].ElemCount -= (idx_expected_size - draw_list->IdxBuffer.Size);
+    draw_list->_VtxWritePtr = vtx_write;
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size;
+}
+
+// Render text with current font, going through the text layout cache when enabled
+static void AddTextCached(ImDrawList* draw_list, const ImVec2& pos, ImU32 col, const char* text, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
+{
+    ImGuiContext& g = *GImGui;
+    if (const ImGuiTextLayout* layout = GetTextLayout(text, text_end, wrap_width))
+        RenderTextLayout(draw_list, layout, pos, col, cpu_fine_clip_rect);
+    else
+        draw_list->AddText(g.Font, g.FontSize, pos, col, text, text_end, wrap_width, cpu_fine_clip_rect);
+}
+
 // Internal ImGui functions to render text
 // RenderText***() functions calls ImDrawList::AddText() calls ImBitmapFont::RenderText()
 void ImGui::RenderText(ImVec2 pos, const char* text, const char* text_end, bool hide_text_after_hash)
@@ -2872,7 +4281,7 @@ void ImGui::RenderText(ImVec2 pos, const char* text, const char* text_end, bool
     const int text_len = (int)(text_display_end - text);
     if (text_len > 0)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_display_end);
+        AddTextCached(window->DrawList, pos, GetColorU32(ImGuiCol_Text), text, text_display_end, 0.0f, NULL);
         if (g.LogEnabled)
             LogRenderedText(pos, text, text_display_end);
     }
@@ -2889,7 +4298,7 @@ void ImGui::RenderTextWrapped(ImVec2 pos, const char* text, const char* text_end
     const int text_len = (int)(text_end - text);
     if (text_len > 0)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        AddTextCached(window->DrawList, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width, NULL);
         if (g.LogEnabled)
             LogRenderedText(pos, text, text_end);
     }
@@ -2926,11 +4335,11 @@ void ImGui::RenderTextClipped(const ImVec2& pos_min, const ImVec2& pos_max, cons
     if (need_clipping)
     {
         ImVec4 fine_clip_rect(clip_min->x, clip_min->y, clip_max->x, clip_max->y);
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_display_end, 0.0f, &fine_clip_rect);
+        AddTextCached(window->DrawList, pos, GetColorU32(ImGuiCol_Text), text, text_display_end, 0.0f, &fine_clip_rect);
     }
     else
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_display_end, 0.0f, NULL);
+        AddTextCached(window->DrawList, pos, GetColorU32(ImGuiCol_Text), text, text_display_end, 0.0f, NULL);
     }
     if (g.LogEnabled)
         LogRenderedText(pos, text, text_display_end);
@@ -3016,20 +4425,16 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     else
         text_display_end = text_end;
 
-    ImFont* font = g.Font;
-    const float font_size = g.FontSize;
     if (text == text_display_end)
-        return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
-
-    // Cancel out character spacing for the last character of a line (it is baked into glyph->XAdvance field)
-    const float font_scale = font_size / font->FontSize;
-    const float character_spacing_x = 1.0f * font_scale;
-    if (text_size.x > 0.0f)
-        text_size.x -= character_spacing_x;
-    text_size.x = (float)(int)(text_size.x + 0.95f);
-
-    return text_size;
+        return ImVec2(0.0f, g.FontSize);
+    if (g.TextLayoutCache.Capacity > 0)
+    {
+        if (!text_display_end)
+            text_display_end = text + strlen(text);
+        if (const ImGuiTextLayout* layout = GetTextLayout(text, text_display_end, wrap_width))
+            return ImVec2(layout->SizeX, layout->SizeY);
+    }
+    return CalcTextSizeNoCache(g.Font, g.FontSize, text, text_display_end, wrap_width);
 }
 
 // Helper to calculate coarse clipping of large list of evenly sized items.
@@ -3061,27 +4466,133 @@ void ImGui::CalcListClipping(int items_count, float items_height, int* out_items
     *out_items_display_end = end;
 }
 
-// Find window given position, search front-to-back
+void ImGuiWindowsHitGrid::Clear()
+{
+    for (int i = 0; i < CellsX * CellsY; i++)
+        Cells[i].~ImVector<int>();
+    ImGui::MemFree(Cells);
+    Cells = NULL;
+    CellsX = CellsY = 0;
+}
+
+void ImGuiWindowsHitGrid::AddWindow(ImGuiWindow* window, const ImRect& rect)
+{
+    IM_ASSERT(window->HitGridCells.Max.x < window->HitGridCells.Min.x);
+    const int x0 = GetCellX(rect.Min.x), y0 = GetCellY(rect.Min.y), x1 = GetCellX(rect.Max.x), y1 = GetCellY(rect.Max.y);
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+            Cells[y * CellsX + x].push_back(window->HotDataIndex);
+    window->HitGridCells = ImRect((float)x0, (float)y0, (float)x1, (float)y1);
+}
+
+void ImGuiWindowsHitGrid::RemoveWindow(ImGuiWindow* window)
+{
+    const int x0 = (int)window->HitGridCells.Min.x, y0 = (int)window->HitGridCells.Min.y, x1 = (int)window->HitGridCells.Max.x, y1 = (int)window->HitGridCells.Max.y;
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+        {
+            ImVector<int>& cell = Cells[y * CellsX + x];
+            for (int n = 0; n < cell.Size; n++)
+                if (cell[n] == window->HotDataIndex)
+                {
+                    cell[n] = cell.back();  // Order within a cell doesn't matter, queries compare DisplayOrder
+                    cell.pop_back();
+                    break;
+                }
+        }
+    window->HitGridCells = ImRect(0.0f, 0.0f, -1.0f, -1.0f);
+}
+
+static void UpdateWindowHotData(ImGuiWindow* window)
+{
+    ImGuiWindowHotData& hot = GImGui->WindowsHotData[window->HotDataIndex];
+    hot.Window = window;
+    hot.Flags = window->Flags;
+    hot.Active = window->Active;
+    hot.WasActive = window->WasActive;
+    hot.MemoryCompacted = window->MemoryCompacted;
+    hot.LastFrameActive = window->LastFrameActive;
+    hot.LastTimeActive = window->LastTimeActive;
+    hot.DisplayOrder = window->DisplayOrder;
+    hot.WindowRectClipped = window->WindowRectClipped;
+}
+
+// Register an active window in the cells overlapped by its clipped rectangle, or unregister it
+static void UpdateWindowHitGrid(ImGuiWindow* window, bool active)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindowsHitGrid& grid = g.WindowsHitGrid;
+    const bool registered = window->HitGridCells.Max.x >= window->HitGridCells.Min.x;
+    if (!active)
+    {
+        if (registered)
+            grid.RemoveWindow(window);
+        return;
+    }
+    if (grid.CellsX == 0)
+        return;
+    ImRect rect(window->WindowRectClipped.Min - grid.TouchExtraPadding, window->WindowRectClipped.Max + grid.TouchExtraPadding);
+    if (registered && window->HitGridCells.Min.x == (float)grid.GetCellX(rect.Min.x) && window->HitGridCells.Min.y == (float)grid.GetCellY(rect.Min.y) && window->HitGridCells.Max.x == (float)grid.GetCellX(rect.Max.x) && window->HitGridCells.Max.y == (float)grid.GetCellY(rect.Max.y))
+        return;
+    if (registered)
+        grid.RemoveWindow(window);
+    grid.AddWindow(window, rect);
+}
+
+// Rebuild the grid when its layout changes (display size or touch padding)
+static void UpdateWindowsHitGridLayout()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindowsHitGrid& grid = g.WindowsHitGrid;
+    if (grid.CellsX > 0 && grid.DisplaySize.x == g.IO.DisplaySize.x && grid.DisplaySize.y == g.IO.DisplaySize.y && grid.TouchExtraPadding.x == g.Style.TouchExtraPadding.x && grid.TouchExtraPadding.y == g.Style.TouchExtraPadding.y)
+        return;
+    grid.Clear();
+    grid.DisplaySize = g.IO.DisplaySize;
+    grid.TouchExtraPadding = g.Style.TouchExtraPadding;
+    grid.CellsX = ImMax(1, (int)ceilf(g.IO.DisplaySize.x / grid.CellSize));
+    grid.CellsY = ImMax(1, (int)ceilf(g.IO.DisplaySize.y / grid.CellSize));
+    grid.Cells = (ImVector<int>*)ImGui::MemAlloc((size_t)(grid.CellsX * grid.CellsY) * sizeof(ImVector<int>));
+    for (int i = 0; i < grid.CellsX * grid.CellsY; i++)
+        IM_PLACEMENT_NEW(&grid.Cells[i]) ImVector<int>();
+    for (int i = 0; i < g.Windows.Size; i++)
+    {
+        ImGuiWindow* window = g.Windows[i];
+        if (window->HitGridCells.Max.x >= window->HitGridCells.Min.x)
+        {
+            window->HitGridCells = ImRect(0.0f, 0.0f, -1.0f, -1.0f);
+            UpdateWindowHitGrid(window, true);
+        }
+    }
+}
+
+// Find window given position, search front-to-back among the windows registered in the grid cell containing the position
 // FIXME: Note that we have a lag here because WindowRectClipped is updated in Begin() so windows moved by user via SetWindowPos() and not SetNextWindowPos() will have that rectangle lagging by a frame at the time FindHoveredWindow() is called, aka before the next Begin(). Moving window thankfully isn't affected.
 static ImGuiWindow* FindHoveredWindow(ImVec2 pos, bool excluding_childs)
 {
     ImGuiContext& g = *GImGui;
-    for (int i = g.Windows.Size-1; i >= 0; i--)
+    const ImGuiWindowsHitGrid& grid = g.WindowsHitGrid;
+    if (grid.CellsX == 0)
+        return NULL;
+    const ImVector<int>& cell = grid.Cells[grid.GetCellY(pos.y) * grid.CellsX + grid.GetCellX(pos.x)];
+    const ImGuiWindowHotData* hovered = NULL;
+    for (int i = 0; i < cell.Size; i++)
     {
-        ImGuiWindow* window = g.Windows[i];
-        if (!window->Active)
+        const ImGuiWindowHotData& hot = g.WindowsHotData[cell[i]];
+        if (!hot.Active)
             continue;
-        if (window->Flags & ImGuiWindowFlags_NoInputs)
+        if (hot.Flags & ImGuiWindowFlags_NoInputs)
             continue;
-        if (excluding_childs && (window->Flags & ImGuiWindowFlags_ChildWindow) != 0)
+        if (excluding_childs && (hot.Flags & ImGuiWindowFlags_ChildWindow) != 0)
+            continue;
+        if (hovered && hovered->DisplayOrder > hot.DisplayOrder)
             continue;
 
         // Using the clipped AABB so a child window will typically be clipped by its parent.
-        ImRect bb(window->WindowRectClipped.Min - g.Style.TouchExtraPadding, window->WindowRectClipped.Max + g.Style.TouchExtraPadding);
+        ImRect bb(hot.WindowRectClipped.Min - g.Style.TouchExtraPadding, hot.WindowRectClipped.Max + g.Style.TouchExtraPadding);
         if (bb.Contains(pos))
-            return window;
+            hovered = &hot;
     }
-    return NULL;
+    return hovered ? hovered->Window : NULL;
 }
 
 // Test if mouse cursor is hovering given rectangle
@@ -3704,6 +5215,7 @@ static void CheckStacksSize(ImGuiWindow* window, bool write)
     { int current = g.CurrentPopupStack.Size;   if (write) *p_backup = current; else IM_ASSERT(*p_backup == current && "BeginMenu/EndMenu or BeginPopup/EndPopup Mismatch"); p_backup++; }// User forgot EndPopup()/EndMenu()
     { int current = g.ColorModifiers.Size;      if (write) *p_backup = current; else IM_ASSERT(*p_backup == current && "PushStyleColor/PopStyleColor Mismatch!");   p_backup++; }    // User forgot PopStyleColor()
     { int current = g.StyleModifiers.Size;      if (write) *p_backup = current; else IM_ASSERT(*p_backup == current && "PushStyleVar/PopStyleVar Mismatch!");       p_backup++; }    // User forgot PopStyleVar()
+    { int current = g.StyleSnapshotBackups.Size; if (write) *p_backup = current; else IM_ASSERT(*p_backup == current && "PushStyleSnapshot/PopStyleSnapshot Mismatch!"); p_backup++; } // User forgot PopStyleSnapshot()
     { int current = g.FontStack.Size;           if (write) *p_backup = current; else IM_ASSERT(*p_backup == current && "PushFont/PopFont Mismatch!");               p_backup++; }    // User forgot PopFont()
     IM_ASSERT(p_backup == window->DC.StackSizesBackup + IM_ARRAYSIZE(window->DC.StackSizesBackup));
 }
@@ -3738,13 +5250,10 @@ static ImVec2 FindBestPopupWindowPos(const ImVec2& base_pos, const ImVec2& size,
 
 ImGuiWindow* ImGui::FindWindowByName(const char* name)
 {
-    // FIXME-OPT: Store sorted hashes -> pointers so we can do a bissection in a contiguous block
+    // Bisection in the sorted hashes -> pointers of g.WindowsById, instead of touching every window
     ImGuiContext& g = *GImGui;
     ImGuiID id = ImHash(name, 0);
-    for (int i = 0; i < g.Windows.Size; i++)
-        if (g.Windows[i]->ID == id)
-            return g.Windows[i];
-    return NULL;
+    return (ImGuiWindow*)g.WindowsById.GetVoidPtr(id);
 }
 
 static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags)
@@ -3807,12 +5316,115 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFl
     }
 
     if (flags & ImGuiWindowFlags_NoBringToFrontOnFocus)
+    {
         g.Windows.insert(g.Windows.begin(), window); // Quite slow but rare and only once
+        window->DisplayOrder = -1;
+    }
     else
+    {
         g.Windows.push_back(window);
+        window->DisplayOrder = g.Windows.Size;
+    }
+
+    g.WindowsById.SetVoidPtr(window->ID, window);
+    if (g.WindowsHotDataFreeSlots.empty())
+    {
+        window->HotDataIndex = g.WindowsHotData.Size;
+        g.WindowsHotData.resize(g.WindowsHotData.Size + 1);
+    }
+    else
+    {
+        window->HotDataIndex = g.WindowsHotDataFreeSlots.back();
+        g.WindowsHotDataFreeSlots.pop_back();
+    }
+    UpdateWindowHotData(window);
     return window;
 }
 
+// Free the draw list buffers and temporary stacks of a window which is not being submitted. They will be reallocated on the next Begin().
+// The state which needs to persist (position, size, scrolling, storage) is preserved.
+static void CompactWindowMemory(ImGuiWindow* window)
+{
+    window->MemoryCompacted = GImGui->WindowsHotData[window->HotDataIndex].MemoryCompacted = true;
+    window->DrawList->ClearFreeMemory();
+    window->IDStack.clear();
+    window->IDStack.push_back(window->ID);
+    window->DC.ChildWindows.clear();
+    window->DC.ItemWidthStack.clear();
+    window->DC.TextWrapPosStack.clear();
+    window->DC.AllowKeyboardFocusStack.clear();
+    window->DC.ButtonRepeatStack.clear();
+    window->DC.GroupStack.clear();
+    window->DC.ColumnsData.clear();
+}
+
+// Remove a window which is not being submitted and clear all references to it. If the window is submitted again it will be recreated from its settings.
+static void DestroyWindow(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(!window->Active && window != g.CurrentWindow);
+    if (!(window->Flags & ImGuiWindowFlags_NoSavedSettings))
+        if (ImGuiIniData* settings = FindWindowSettings(window->Name))
+        {
+            settings->Pos = window->Pos;
+            settings->Size = window->SizeFull;
+            settings->Collapsed = window->Collapsed;
+        }
+
+    for (int i = 0; i < g.Windows.Size; i++)
+    {
+        ImGuiWindow* other = g.Windows[i];
+        if (other->RootWindow == window)
+            other->RootWindow = other;
+        if (other->RootNonPopupWindow == window)
+            other->RootNonPopupWindow = other;
+        if (other->ParentWindow == window)
+            other->ParentWindow = NULL;
+        for (int n = 0; n < other->DC.ChildWindows.Size; n++)
+            if (other->DC.ChildWindows[n] == window)
+                other->DC.ChildWindows.erase(other->DC.ChildWindows.Data + n--);
+    }
+    UpdateWindowHitGrid(window, false);
+    if (g.FocusedWindow == window)
+        g.FocusedWindow = NULL;
+    if (g.HoveredWindow == window)
+        g.HoveredWindow = NULL;
+    if (g.HoveredRootWindow == window)
+        g.HoveredRootWindow = NULL;
+
+    for (int i = 0; i < g.Windows.Size; i++)
+        if (g.Windows[i] == window)
+        {
+            g.Windows.erase(g.Windows.Data + i);
+            break;
+        }
+    g.WindowsById.SetVoidPtr(window->ID, NULL);
+    g.WindowsHotData[window->HotDataIndex] = ImGuiWindowHotData();
+    g.WindowsHotDataFreeSlots.push_back(window->HotDataIndex);
+    window->~ImGuiWindow();
+    ImGui::MemFree(window);
+}
+
+// Heap memory owned by a window, for display in ShowMetricsWindow()
+static size_t CalcWindowMemoryUsage(ImGuiWindow* window)
+{
+    size_t size = sizeof(ImGuiWindow) + sizeof(ImDrawList) + strlen(window->Name) + 1;
+    const ImDrawList* draw_list = window->DrawList;
+    size += draw_list->CmdBuffer.Capacity * sizeof(ImDrawCmd) + draw_list->IdxBuffer.Capacity * sizeof(ImDrawIdx) + draw_list->VtxBuffer.Capacity * sizeof(ImDrawVert);
+    size += draw_list->IdxSpans.Capacity * sizeof(ImDrawIdxSpan) + draw_list->_ClipRectStack.Capacity * sizeof(ImVec4) + draw_list->_TextureIdStack.Capacity * sizeof(ImTextureID) + draw_list->_Path.Capacity * sizeof(ImVec2);
+    size += draw_list->_Channels.Capacity * sizeof(ImDrawChannel);
+    for (int i = 1; i < draw_list->_Channels.Size; i++) // Channel 0 shares its buffers with CmdBuffer/IdxBuffer
+        size += draw_list->_Channels[i].CmdBuffer.Capacity * sizeof(ImDrawCmd) + draw_list->_Channels[i].IdxBuffer.Capacity * sizeof(ImDrawIdx);
+    size += draw_list->_IdxSpansBuffers.Capacity * sizeof(ImVector<ImDrawIdx>);
+    for (int i = 0; i < draw_list->_IdxSpansBuffers.Size; i++)
+        size += draw_list->_IdxSpansBuffers[i].Capacity * sizeof(ImDrawIdx);
+    size += window->IDStack.Capacity * sizeof(ImGuiID) + window->StateStorage.Data.Capacity * sizeof(ImGuiStorage::Pair);
+    size += window->DC.ChildWindows.Capacity * sizeof(ImGuiWindow*) + window->DC.ItemWidthStack.Capacity * sizeof(float) + window->DC.TextWrapPosStack.Capacity * sizeof(float);
+    size += window->DC.AllowKeyboardFocusStack.Capacity * sizeof(bool) + window->DC.ButtonRepeatStack.Capacity * sizeof(bool) + window->DC.GroupStack.Capacity * sizeof(ImGuiGroupData);
+    size += window->DC.ColumnsData.Capacity * sizeof(ImGuiColumnData);
+    return size;
+}
+
 static void ApplySizeFullWithConstraint(ImGuiWindow* window, ImVec2 new_size)
 {
     ImGuiContext& g = *GImGui;
@@ -3838,6 +5450,22 @@ static void ApplySizeFullWithConstraint(ImGuiWindow* window, ImVec2 new_size)
     window->SizeFull = new_size;
 }
 
+// Float fields are compared by value: -0.0f matches 0.0f and a NaN never matches, so the layout is then evaluated again
+static bool LayoutInputsEqual(const ImGuiWindowLayoutInputs& a, const ImGuiWindowLayoutInputs& b)
+{
+    return a.SizeConstraintCallback == b.SizeConstraintCallback && a.SizeConstraintCallbackUserData == b.SizeConstraintCallbackUserData &&
+        a.SizeContents.x == b.SizeContents.x && a.SizeContents.y == b.SizeContents.y &&
+        a.SizeFull.x == b.SizeFull.x && a.SizeFull.y == b.SizeFull.y &&
+        a.WindowPadding.x == b.WindowPadding.x && a.WindowPadding.y == b.WindowPadding.y &&
+        a.WindowMinSize.x == b.WindowMinSize.x && a.WindowMinSize.y == b.WindowMinSize.y &&
+        a.DisplaySize.x == b.DisplaySize.x && a.DisplaySize.y == b.DisplaySize.y &&
+        a.ItemSpacingScrollbarSize.x == b.ItemSpacingScrollbarSize.x && a.ItemSpacingScrollbarSize.y == b.ItemSpacingScrollbarSize.y &&
+        a.SizeConstraintPos.x == b.SizeConstraintPos.x && a.SizeConstraintPos.y == b.SizeConstraintPos.y &&
+        a.SizeConstraintRect.Min.x == b.SizeConstraintRect.Min.x && a.SizeConstraintRect.Min.y == b.SizeConstraintRect.Min.y &&
+        a.SizeConstraintRect.Max.x == b.SizeConstraintRect.Max.x && a.SizeConstraintRect.Max.y == b.SizeConstraintRect.Max.y &&
+        a.Flags == b.Flags && a.State == b.State;
+}
+
 // Push a new ImGui window to add widgets to.
 // - A default window called "Debug" is automatically stacked at the beginning of every frame so you can use widgets without explicitly calling a Begin/End pair.
 // - Begin/End can be called multiple times during the frame with the same window name to append content.
@@ -3966,10 +5594,14 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         window->BeginCount = 0;
         window->ClipRect = ImVec4(-FLT_MAX,-FLT_MAX,+FLT_MAX,+FLT_MAX);
         window->LastFrameActive = current_frame;
+        window->LastTimeActive = (float)g.Time;
+        window->MemoryCompacted = false;
         window->IDStack.resize(1);
 
         // Clear draw list, setup texture, outer clipping rectangle
         window->DrawList->Clear();
+        window->DrawList->UseIdxSpans = g.IO.DrawListsUseIdxSpans;
+        window->DrawList->UseBuffersPool = (g.IO.DrawBuffersPoolDecayFrames >= 0);
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         ImRect fullscreen_rect(GetVisibleRect());
         if ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & (ImGuiWindowFlags_ComboBox|ImGuiWindowFlags_Popup)))
@@ -4026,55 +5658,93 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         // Lock window padding so that altering the ShowBorders flag for children doesn't have side-effects.
         window->WindowPadding = ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & (ImGuiWindowFlags_AlwaysUseWindowPadding | ImGuiWindowFlags_ShowBorders | ImGuiWindowFlags_ComboBox | ImGuiWindowFlags_Popup))) ? ImVec2(0,0) : style.WindowPadding;
 
-        // Calculate auto-fit size
-        ImVec2 size_auto_fit;
-        if ((flags & ImGuiWindowFlags_Tooltip) != 0)
-        {
-            // Tooltip always resize. We keep the spacing symmetric on both axises for aesthetic purpose.
-            size_auto_fit = window->SizeContents + window->WindowPadding - ImVec2(0.0f, style.ItemSpacing.y);
-        }
-        else
+        // Gather the inputs of the size computations below. If they are the same as last frame's the layout is stable and the computations would give the same results,
+        // so we reuse them instead of evaluating the auto-fit, the size constraints (and their callback) and the scrollbars again.
+        ImGuiWindowLayoutInputs layout_inputs;
+        layout_inputs.SizeContents = window->SizeContents;
+        layout_inputs.SizeFull = window->SizeFull;
+        layout_inputs.WindowPadding = window->WindowPadding;
+        layout_inputs.WindowMinSize = style.WindowMinSize;
+        layout_inputs.DisplaySize = g.IO.DisplaySize - style.DisplaySafeAreaPadding;
+        layout_inputs.ItemSpacingScrollbarSize = ImVec2(style.ItemSpacing.y, style.ScrollbarSize);
+        if (g.SetNextWindowSizeConstraint)
         {
-            size_auto_fit = ImClamp(window->SizeContents + window->WindowPadding, style.WindowMinSize, ImMax(style.WindowMinSize, g.IO.DisplaySize - g.Style.DisplaySafeAreaPadding));
-
-            // Handling case of auto fit window not fitting in screen on one axis, we are growing auto fit size on the other axis to compensate for expected scrollbar. FIXME: Might turn bigger than DisplaySize-WindowPadding.
-            if (size_auto_fit.x < window->SizeContents.x && !(flags & ImGuiWindowFlags_NoScrollbar) && (flags & ImGuiWindowFlags_HorizontalScrollbar))
-                size_auto_fit.y += style.ScrollbarSize;
-            if (size_auto_fit.y < window->SizeContents.y && !(flags & ImGuiWindowFlags_NoScrollbar))
-                size_auto_fit.x += style.ScrollbarSize;
-            size_auto_fit.y = ImMax(size_auto_fit.y - style.ItemSpacing.y, 0.0f);
+            layout_inputs.SizeConstraintRect = g.SetNextWindowSizeConstraintRect;
+            layout_inputs.SizeConstraintCallback = g.SetNextWindowSizeConstraintCallback;
+            layout_inputs.SizeConstraintCallbackUserData = g.SetNextWindowSizeConstraintCallbackUserData;
+            if (g.SetNextWindowSizeConstraintCallback)
+                layout_inputs.SizeConstraintPos = window->Pos;
         }
+        layout_inputs.Flags = flags;
+        layout_inputs.State = (window->AutoFitFramesX > 0 ? ImGuiWindowLayoutState_AutoFitX : 0) | (window->AutoFitFramesY > 0 ? ImGuiWindowLayoutState_AutoFitY : 0) | (window->AutoFitOnlyGrows ? ImGuiWindowLayoutState_AutoFitOnlyGrows : 0);
+        layout_inputs.State |= (window->Collapsed ? ImGuiWindowLayoutState_Collapsed : 0) | (window_size_set_by_api ? ImGuiWindowLayoutState_SizeSetByApi : 0);
+        const bool layout_stable = window_was_active && LayoutInputsEqual(layout_inputs, window->LayoutInputs);
+        window->LayoutInputs = layout_inputs;
+        window->LayoutStableFrames = layout_stable ? window->LayoutStableFrames + 1 : 0;
 
-        // Handle automatic resize
-        if (window->Collapsed)
+        ImVec2 size_auto_fit;
+        if (layout_stable)
         {
-            // We still process initial auto-fit on collapsed windows to get a window width,
-            // But otherwise we don't honor ImGuiWindowFlags_AlwaysAutoResize when collapsed.
-            if (window->AutoFitFramesX > 0)
-                window->SizeFull.x = window->AutoFitOnlyGrows ? ImMax(window->SizeFull.x, size_auto_fit.x) : size_auto_fit.x;
-            if (window->AutoFitFramesY > 0)
-                window->SizeFull.y = window->AutoFitOnlyGrows ? ImMax(window->SizeFull.y, size_auto_fit.y) : size_auto_fit.y;
+            size_auto_fit = window->LayoutSizeAutoFit;
+            window->SizeFull = window->LayoutSizeFull;
+
+            // Auto-fit has converged: last frame's fit was computed from the same contents and size, so there is nothing left to fit.
+            // End it now instead of waiting for the frame counters to run out, which makes the resize grip and position clamping available again.
+            window->AutoFitFramesX = window->AutoFitFramesY = 0;
         }
         else
         {
-            if ((flags & ImGuiWindowFlags_AlwaysAutoResize) && !window_size_set_by_api)
+            // Calculate auto-fit size
+            if ((flags & ImGuiWindowFlags_Tooltip) != 0)
+            {
+                // Tooltip always resize. We keep the spacing symmetric on both axises for aesthetic purpose.
+                size_auto_fit = window->SizeContents + window->WindowPadding - ImVec2(0.0f, style.ItemSpacing.y);
+            }
+            else
             {
-                window->SizeFull = size_auto_fit;
+                size_auto_fit = ImClamp(window->SizeContents + window->WindowPadding, style.WindowMinSize, ImMax(style.WindowMinSize, g.IO.DisplaySize - g.Style.DisplaySafeAreaPadding));
+
+                // Handling case of auto fit window not fitting in screen on one axis, we are growing auto fit size on the other axis to compensate for expected scrollbar. FIXME: Might turn bigger than DisplaySize-WindowPadding.
+                if (size_auto_fit.x < window->SizeContents.x && !(flags & ImGuiWindowFlags_NoScrollbar) && (flags & ImGuiWindowFlags_HorizontalScrollbar))
+                    size_auto_fit.y += style.ScrollbarSize;
+                if (size_auto_fit.y < window->SizeContents.y && !(flags & ImGuiWindowFlags_NoScrollbar))
+                    size_auto_fit.x += style.ScrollbarSize;
+                size_auto_fit.y = ImMax(size_auto_fit.y - style.ItemSpacing.y, 0.0f);
             }
-            else if ((window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0) && !window_size_set_by_api)
+
+            // Handle automatic resize
+            if (window->Collapsed)
             {
-                // Auto-fit only grows during the first few frames
+                // We still process initial auto-fit on collapsed windows to get a window width,
+                // But otherwise we don't honor ImGuiWindowFlags_AlwaysAutoResize when collapsed.
                 if (window->AutoFitFramesX > 0)
                     window->SizeFull.x = window->AutoFitOnlyGrows ? ImMax(window->SizeFull.x, size_auto_fit.x) : size_auto_fit.x;
                 if (window->AutoFitFramesY > 0)
                     window->SizeFull.y = window->AutoFitOnlyGrows ? ImMax(window->SizeFull.y, size_auto_fit.y) : size_auto_fit.y;
-                if (!(flags & ImGuiWindowFlags_NoSavedSettings))
-                    MarkSettingsDirty();
             }
-        }
+            else
+            {
+                if ((flags & ImGuiWindowFlags_AlwaysAutoResize) && !window_size_set_by_api)
+                {
+                    window->SizeFull = size_auto_fit;
+                }
+                else if ((window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0) && !window_size_set_by_api)
+                {
+                    // Auto-fit only grows during the first few frames
+                    if (window->AutoFitFramesX > 0)
+                        window->SizeFull.x = window->AutoFitOnlyGrows ? ImMax(window->SizeFull.x, size_auto_fit.x) : size_auto_fit.x;
+                    if (window->AutoFitFramesY > 0)
+                        window->SizeFull.y = window->AutoFitOnlyGrows ? ImMax(window->SizeFull.y, size_auto_fit.y) : size_auto_fit.y;
+                    if (!(flags & ImGuiWindowFlags_NoSavedSettings))
+                        MarkSettingsDirty();
+                }
+            }
 
-        // Apply minimum/maximum window size constraints and final size
-        ApplySizeFullWithConstraint(window, window->SizeFull);
+            // Apply minimum/maximum window size constraints and final size
+            ApplySizeFullWithConstraint(window, window->SizeFull);
+            window->LayoutSizeFull = window->SizeFull;
+            window->LayoutSizeAutoFit = size_auto_fit;
+        }
         window->Size = window->Collapsed ? window->TitleBarRect().GetSize() : window->SizeFull;
         
         // POSITION
@@ -4166,7 +5836,12 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
 
         // Modal window darkens what is behind them
         if ((flags & ImGuiWindowFlags_Modal) != 0 && window == GetFrontMostModalRootWindow())
-            window->DrawList->AddRectFilled(fullscreen_rect.Min, fullscreen_rect.Max, GetColorU32(ImGuiCol_ModalWindowDarkening, g.ModalWindowDarkeningRatio));
+        {
+            const ImU32 darkening_col = GetColorU32(ImGuiCol_ModalWindowDarkening, g.ModalWindowDarkeningRatio);
+            window->DrawList->AddRectFilled(fullscreen_rect.Min, fullscreen_rect.Max, darkening_col);
+            if (((darkening_col >> IM_COL32_A_SHIFT) & 0xFF) == 0xFF)
+                window->DrawList->_OpaqueRect = ImVec4(fullscreen_rect.Min.x, fullscreen_rect.Min.y, fullscreen_rect.Max.x, fullscreen_rect.Max.y);
+        }
 
         // Draw window + handle manual resize
         ImRect title_bar_rect = window->TitleBarRect();
@@ -4213,10 +5888,14 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
                 title_bar_rect = window->TitleBarRect();
             }
 
-            // Scrollbars
-            window->ScrollbarY = (flags & ImGuiWindowFlags_AlwaysVerticalScrollbar) || ((window->SizeContents.y > window->Size.y + style.ItemSpacing.y) && !(flags & ImGuiWindowFlags_NoScrollbar));
-            window->ScrollbarX = (flags & ImGuiWindowFlags_AlwaysHorizontalScrollbar) || ((window->SizeContents.x > window->Size.x - (window->ScrollbarY ? style.ScrollbarSize : 0.0f) - window->WindowPadding.x) && !(flags & ImGuiWindowFlags_NoScrollbar) && (flags & ImGuiWindowFlags_HorizontalScrollbar));
-            window->ScrollbarSizes = ImVec2(window->ScrollbarY ? style.ScrollbarSize : 0.0f, window->ScrollbarX ? style.ScrollbarSize : 0.0f);
+            // Scrollbars (kept from last frame when the layout is stable and the window wasn't resized)
+            if (!layout_stable || window->Size.x != window->LayoutScrollbarsSize.x || window->Size.y != window->LayoutScrollbarsSize.y)
+            {
+                window->ScrollbarY = (flags & ImGuiWindowFlags_AlwaysVerticalScrollbar) || ((window->SizeContents.y > window->Size.y + style.ItemSpacing.y) && !(flags & ImGuiWindowFlags_NoScrollbar));
+                window->ScrollbarX = (flags & ImGuiWindowFlags_AlwaysHorizontalScrollbar) || ((window->SizeContents.x > window->Size.x - (window->ScrollbarY ? style.ScrollbarSize : 0.0f) - window->WindowPadding.x) && !(flags & ImGuiWindowFlags_NoScrollbar) && (flags & ImGuiWindowFlags_HorizontalScrollbar));
+                window->ScrollbarSizes = ImVec2(window->ScrollbarY ? style.ScrollbarSize : 0.0f, window->ScrollbarX ? style.ScrollbarSize : 0.0f);
+                window->LayoutScrollbarsSize = window->Size;
+            }
             window->BorderSize = (flags & ImGuiWindowFlags_ShowBorders) ? 1.0f : 0.0f;
 
             // Window background, Default Alpha
@@ -4235,8 +5914,20 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
                 window->DrawList->AddRectFilled(window->Pos+ImVec2(0,window->TitleBarHeight()), window->Pos+window->Size, ColorConvertFloat4ToU32(bg_color), window_rounding, (flags & ImGuiWindowFlags_NoTitleBar) ? ImGuiCorner_All : ImGuiCorner_BottomLeft|ImGuiCorner_BottomRight);
 
             // Title bar
+            const ImU32 title_bar_col = GetColorU32((g.FocusedWindow && window->RootNonPopupWindow == g.FocusedWindow->RootNonPopupWindow) ? ImGuiCol_TitleBgActive : ImGuiCol_TitleBg);
             if (!(flags & ImGuiWindowFlags_NoTitleBar))
-                window->DrawList->AddRectFilled(title_bar_rect.GetTL(), title_bar_rect.GetBR(), GetColorU32((g.FocusedWindow && window->RootNonPopupWindow == g.FocusedWindow->RootNonPopupWindow) ? ImGuiCol_TitleBgActive : ImGuiCol_TitleBg), window_rounding, ImGuiCorner_TopLeft|ImGuiCorner_TopRight);
+                window->DrawList->AddRectFilled(title_bar_rect.GetTL(), title_bar_rect.GetBR(), title_bar_col, window_rounding, ImGuiCorner_TopLeft|ImGuiCorner_TopRight);
+
+            // Part of the window covered by an opaque background, minus the rounded corners. Render() culls what is drawn behind it.
+            if (bg_color.w >= 1.0f && window->DrawList->_OpaqueRect.x >= window->DrawList->_OpaqueRect.z)
+            {
+                ImRect opaque_rect(window->Pos + ImVec2(0.0f, window->TitleBarHeight()), window->Pos + window->Size);
+                if (!(flags & ImGuiWindowFlags_NoTitleBar) && ((title_bar_col >> IM_COL32_A_SHIFT) & 0xFF) == 0xFF)
+                    opaque_rect.Min.y = window->Pos.y;
+                opaque_rect.Expand(-window_rounding);
+                opaque_rect.Clip(window->ClipRect);
+                window->DrawList->_OpaqueRect = ImVec4(opaque_rect.Min.x, opaque_rect.Min.y, opaque_rect.Max.x, opaque_rect.Max.y);
+            }
 
             // Menu bar
             if (flags & ImGuiWindowFlags_MenuBar)
@@ -4354,6 +6045,8 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
         // Save clipped aabb so we can access it in constant-time in FindHoveredWindow()
         window->WindowRectClipped = window->Rect();
         window->WindowRectClipped.Clip(window->ClipRect);
+        UpdateWindowHotData(window);
+        UpdateWindowHitGrid(window, true);
 
         // Pressing CTRL+C while holding on a window copy its content to the clipboard
         // This works but 1. doesn't handle multiple Begin/End pairs, 2. recursing into another Begin/End pair - so we need to work that out and add better logging scope.
@@ -4400,6 +6093,7 @@ bool ImGui::Begin(const char* name, bool* p_open, const ImVec2& size_on_first_us
     }
     if (style.Alpha <= 0.0f)
         window->Active = false;
+    g.WindowsHotData[window->HotDataIndex].Active = window->Active;
 
     // Return false if we don't intend to display anything to allow user to perform an early out optimization
     window->SkipItems = (window->Collapsed || !window->Active) && window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0;
@@ -4773,6 +6467,38 @@ void ImGui::PopStyleVar(int count)
     }
 }
 
+void ImGuiStyleSnapshot::Bake()
+{
+    BakeStyleColors(Style, ColorsU32);
+}
+
+// Save the current style and packed colors, then replace them with the snapshot ones. No color conversion is done.
+void ImGui::PushStyleSnapshot(const ImGuiStyleSnapshot& snapshot)
+{
+    ImGuiContext& g = *GImGui;
+    for (int n = 0; n < ImGuiCol_COUNT; n++)    // Bring the packed colors up to date, only converting the colors modified since they were computed
+        GetColorU32(n);
+    g.StyleSnapshotBackups.resize(g.StyleSnapshotBackups.Size + 1);
+    ImGuiStyleSnapshot& backup = g.StyleSnapshotBackups.back();
+    backup.Style = g.Style;
+    memcpy(backup.ColorsU32, g.StyleColorsU32, sizeof(g.StyleColorsU32));
+    g.Style = snapshot.Style;
+    SetStyleColorsU32(snapshot.Style, snapshot.ColorsU32);
+}
+
+void ImGui::PopStyleSnapshot(int count)
+{
+    ImGuiContext& g = *GImGui;
+    while (count > 0)
+    {
+        const ImGuiStyleSnapshot& backup = g.StyleSnapshotBackups.back();
+        g.Style = backup.Style;
+        SetStyleColorsU32(backup.Style, backup.ColorsU32);
+        g.StyleSnapshotBackups.pop_back();
+        count--;
+    }
+}
+
 const char* ImGui::GetStyleColName(ImGuiCol idx)
 {
     // Create switch-case from enum with regexp: ImGuiCol_{.*}, --> case ImGuiCol_\1: return "\1";
@@ -6257,9 +7983,9 @@ void ImGui::BulletText(const char* fmt, ...)
 static inline void DataTypeFormatString(ImGuiDataType data_type, void* data_ptr, const char* display_format, char* buf, int buf_size)
 {
     if (data_type == ImGuiDataType_Int)
-        ImFormatString(buf, buf_size, display_format, *(int*)data_ptr);
+        ImGui::FormatScalar(buf, buf_size, display_format, *(int*)data_ptr);
     else if (data_type == ImGuiDataType_Float)
-        ImFormatString(buf, buf_size, display_format, *(float*)data_ptr);
+        ImGui::FormatScalar(buf, buf_size, display_format, *(float*)data_ptr);
 }
 
 static inline void DataTypeFormatString(ImGuiDataType data_type, void* data_ptr, int decimal_precision, char* buf, int buf_size)
@@ -6393,7 +8119,7 @@ bool ImGui::InputScalarAsWidgetReplacement(const ImRect& aabb, const char* label
 }
 
 // Parse display precision back from the display format string
-int ImGui::ParseFormatPrecision(const char* fmt, int default_precision)
+static int ParseFormatPrecisionNoCache(const char* fmt, int default_precision)
 {
     int precision = default_precision;
     while ((fmt = strchr(fmt, '%')) != NULL)
@@ -6413,6 +8139,103 @@ int ImGui::ParseFormatPrecision(const char* fmt, int default_precision)
     return precision;
 }
 
+// Display formats are parsed once and cached by pointer, as scalar widgets pass the same format every frame.
+// Returns NULL for formats too long to be cached.
+static const ImGuiParsedFormat* GetParsedFormat(const char* fmt)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiParsedFormat& pf = g.FormatCache[((size_t)(intptr_t)fmt >> 2) & (IM_ARRAYSIZE(g.FormatCache) - 1)];
+    if (pf.Key == fmt && strcmp(pf.Format, fmt) == 0)
+        return &pf;
+
+    const int fmt_len = (int)strlen(fmt);
+    if (fmt_len >= IM_ARRAYSIZE(pf.Format))
+        return NULL;
+    pf.Key = fmt;
+    memcpy(pf.Format, fmt, (size_t)fmt_len + 1);
+    pf.Precision = ParseFormatPrecisionNoCache(fmt, -1);
+    pf.Type = 0;
+
+    // Fast paths are used for a single "%d", "%i", "%f", "%.Nf" (N <= 9), "%g" or "%.Ng" (N <= 6), with literal text around
+    const char* p = fmt;
+    while (*p && (p[0] != '%' || p[1] == '%'))
+        p += (p[0] == '%') ? 2 : 1;
+    if (*p == 0)
+        return &pf;
+    pf.SpecBegin = (int)(p - fmt);
+    p++;
+    int spec_precision = -1;
+    if (*p == '.')
+        for (spec_precision = 0, p++; *p >= '0' && *p <= '9' && spec_precision < 100; p++)
+            spec_precision = spec_precision * 10 + (*p - '0');
+    const char conv = *p;
+    if (conv)
+        p++;
+    pf.SpecEnd = (int)(p - fmt);
+    for (; *p; p++)
+        if (*p == '%' && *++p != '%')
+            return &pf;
+    if ((conv == 'd' || conv == 'i') && spec_precision < 0)
+        pf.Type = 'd';
+    else if (conv == 'f' && spec_precision <= 9)
+        pf.Type = 'f';
+    else if (conv == 'g' && spec_precision <= 6)
+        pf.Type = 'g';
+    pf.SpecPrecision = (spec_precision >= 0) ? spec_precision : 6;
+    if (pf.Type == 'g' && pf.SpecPrecision == 0)
+        pf.SpecPrecision = 1;
+    return &pf;
+}
+
+int ImGui::ParseFormatPrecision(const char* fmt, int default_precision)
+{
+    if (const ImGuiParsedFormat* pf = GetParsedFormat(fmt))
+        return (pf->Precision >= 0) ? pf->Precision : default_precision;
+    return ParseFormatPrecisionNoCache(fmt, default_precision);
+}
+
+// Assemble the literal text of a parsed format around an already formatted value
+static int FormatParsed(char* buf, int buf_size, const ImGuiParsedFormat* pf, const char* value, int value_len)
+{
+    IM_ASSERT(buf_size > 0);
+    char* p = buf;
+    char* p_end = buf + buf_size - 1;
+    for (const char* s = pf->Format; s < pf->Format + pf->SpecBegin && p < p_end; s += (s[0] == '%') ? 2 : 1)
+        *p++ = s[0];
+    for (int n = 0; n < value_len && p < p_end; n++)
+        *p++ = value[n];
+    for (const char* s = pf->Format + pf->SpecEnd; *s && p < p_end; s += (s[0] == '%') ? 2 : 1)
+        *p++ = s[0];
+    *p = 0;
+    return (int)(p - buf);
+}
+
+// Same output as ImFormatString(buf, buf_size, fmt, v), without going through vsnprintf for the common formats
+int ImGui::FormatScalar(char* buf, int buf_size, const char* fmt, float v)
+{
+    const ImGuiParsedFormat* pf = GetParsedFormat(fmt);
+    if (pf && (pf->Type == 'f' || pf->Type == 'g'))
+    {
+        char value_buf[32];
+        const int value_len = (pf->Type == 'f') ? ImFormatFloatFixed(value_buf, v, pf->SpecPrecision) : ImFormatFloatGeneral(value_buf, v, pf->SpecPrecision);
+        if (value_len >= 0)
+            return FormatParsed(buf, buf_size, pf, value_buf, value_len);
+    }
+    return ImFormatString(buf, buf_size, fmt, v);
+}
+
+int ImGui::FormatScalar(char* buf, int buf_size, const char* fmt, int v)
+{
+    const ImGuiParsedFormat* pf = GetParsedFormat(fmt);
+    if (pf && pf->Type == 'd')
+    {
+        char value_buf[16];
+        const int value_len = ImFormatInt(value_buf, v);
+        return FormatParsed(buf, buf_size, pf, value_buf, value_len);
+    }
+    return ImFormatString(buf, buf_size, fmt, v);
+}
+
 float ImGui::RoundScalar(float value, int decimal_precision)
 {
     // Round past decimal precision
@@ -6617,7 +8440,7 @@ bool ImGui::SliderFloat(const char* label, float* v, float v_min, float v_max, c
 
     // Display value using user-provided display format so user can add prefix/suffix/decorations to the value.
     char value_buf[64];
-    const char* value_buf_end = value_buf + ImFormatString(value_buf, IM_ARRAYSIZE(value_buf), display_format, *v);
+    const char* value_buf_end = value_buf + FormatScalar(value_buf, IM_ARRAYSIZE(value_buf), display_format, *v);
     RenderTextClipped(frame_bb.Min, frame_bb.Max, value_buf, value_buf_end, NULL, ImVec2(0.5f,0.5f));
 
     if (label_size.x > 0.0f)
@@ -6664,7 +8487,7 @@ bool ImGui::VSliderFloat(const char* label, const ImVec2& size, float* v, float
     // Display value using user-provided display format so user can add prefix/suffix/decorations to the value.
     // For the vertical slider we allow centered text to overlap the frame padding
     char value_buf[64];
-    char* value_buf_end = value_buf + ImFormatString(value_buf, IM_ARRAYSIZE(value_buf), display_format, *v);
+    char* value_buf_end = value_buf + FormatScalar(value_buf, IM_ARRAYSIZE(value_buf), display_format, *v);
     RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max, value_buf, value_buf_end, NULL, ImVec2(0.5f,0.0f));
     if (label_size.x > 0.0f)
         RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label);
@@ -6914,7 +8737,7 @@ bool ImGui::DragFloat(const char* label, float* v, float v_speed, float v_min, f
 
     // Display value using user-provided display format so user can add prefix/suffix/decorations to the value.
     char value_buf[64];
-    const char* value_buf_end = value_buf + ImFormatString(value_buf, IM_ARRAYSIZE(value_buf), display_format, *v);
+    const char* value_buf_end = value_buf + FormatScalar(value_buf, IM_ARRAYSIZE(value_buf), display_format, *v);
     RenderTextClipped(frame_bb.Min, frame_bb.Max, value_buf, value_buf_end, NULL, ImVec2(0.5f,0.5f));
 
     if (label_size.x > 0.0f)
@@ -7239,7 +9062,7 @@ void ImGui::ProgressBar(float fraction, const ImVec2& size_arg, const char* over
     char overlay_buf[32];
     if (!overlay)
     {
-        ImFormatString(overlay_buf, IM_ARRAYSIZE(overlay_buf), "%.0f%%", fraction*100+0.01f);
+        FormatScalar(overlay_buf, IM_ARRAYSIZE(overlay_buf), "%.0f%%", fraction*100+0.01f);
         overlay = overlay_buf;
     }
 
@@ -7810,14 +9633,14 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         if (edit_state.SelectedAllMouseLock && !io.MouseDown[0])
             edit_state.SelectedAllMouseLock = false;
 
-        if (io.InputCharacters[0])
+        if (g.InputCharacters.Size > 0 && g.InputCharacters[0])
         {
             // Process text input (before we check for Return because using some IME will effectively send a Return?)
             // We ignore CTRL inputs, but need to allow CTRL+ALT as some keyboards (e.g. German) use AltGR - which is Alt+Ctrl - to input certain characters.
             if (!(io.KeyCtrl && !io.KeyAlt) && is_editable)
             {
-                for (int n = 0; n < IM_ARRAYSIZE(io.InputCharacters) && io.InputCharacters[n]; n++)
-                    if (unsigned int c = (unsigned int)io.InputCharacters[n])
+                for (int n = 0; n < g.InputCharacters.Size && g.InputCharacters[n]; n++)
+                    if (unsigned int c = (unsigned int)g.InputCharacters[n])
                     {
                         // Insert character if they pass filtering
                         if (!InputTextFilterCharacter(&c, flags, callback, user_data))
@@ -7827,6 +9650,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
             }
 
             // Consume characters
+            g.InputCharacters.resize(0);
             memset(g.IO.InputCharacters, 0, sizeof(g.IO.InputCharacters));
         }
 
@@ -8275,11 +10099,16 @@ bool ImGui::InputScalarEx(const char* label, ImGuiDataType data_type, void* data
 
 bool ImGui::InputFloat(const char* label, float* v, float step, float step_fast, int decimal_precision, ImGuiInputTextFlags extra_flags)
 {
-    char display_format[16];
+    // Use static format strings for the common precisions, so their parsing stays cached
+    static const char* display_formats[10] = { "%.0f", "%.1f", "%.2f", "%.3f", "%.4f", "%.5f", "%.6f", "%.7f", "%.8f", "%.9f" };
+    char display_format_buf[16];
+    const char* display_format = display_format_buf;
     if (decimal_precision < 0)
-        strcpy(display_format, "%f");      // Ideally we'd have a minimum decimal precision of 1 to visually denote that this is a float, while hiding non-significant digits? %f doesn't have a minimum of 1
+        display_format = "%f";      // Ideally we'd have a minimum decimal precision of 1 to visually denote that this is a float, while hiding non-significant digits? %f doesn't have a minimum of 1
+    else if (decimal_precision < IM_ARRAYSIZE(display_formats))
+        display_format = display_formats[decimal_precision];
     else
-        ImFormatString(display_format, IM_ARRAYSIZE(display_format), "%%.%df", decimal_precision);
+        ImFormatString(display_format_buf, IM_ARRAYSIZE(display_format_buf), "%%.%df", decimal_precision);
     return InputScalarEx(label, ImGuiDataType_Float, (void*)v, (void*)(step>0.0f ? &step : NULL), (void*)(step_fast>0.0f ? &step_fast : NULL), display_format, extra_flags);
 }
 
@@ -8384,23 +10213,75 @@ static bool Items_ArrayGetter(void* data, int idx, const char** out_text)
     return true;
 }
 
-static bool Items_SingleStringGetter(void* data, int idx, const char** out_text)
+// Index the items of a zero-separated string. The index is cached per string pointer. Every frame we only check that the string still ends at the same offset,
+// so the cost of a closed Combo() doesn't depend on its number of items. On the first frame the popup may be open, the offsets are checked against the whole string:
+// this walks the items like building the index does (so it never reads past the end of the current string) but doesn't allocate.
+static bool ItemsIndexMatches(const ImGuiItemsIndex* index, const char* items_separated_by_zeros)
 {
-    // FIXME-OPT: we could pre-compute the indices to fasten this. But only 1 active combo means the waste is limited.
-    const char* items_separated_by_zeros = (const char*)data;
-    int items_count = 0;
     const char* p = items_separated_by_zeros;
-    while (*p)
+    for (int n = 0; n < index->Offsets.Size; n++)
     {
-        if (idx == items_count)
-            break;
+        if (*p == 0 || (int)(p - items_separated_by_zeros) != index->Offsets[n])
+            return false;
         p += strlen(p) + 1;
-        items_count++;
     }
-    if (!*p)
+    return *p == 0;
+}
+
+static ImGuiItemsIndex* GetItemsIndex(const char* items_separated_by_zeros, bool popup_may_be_open)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiItemsIndex* index = NULL;
+    for (int i = 0; i < g.ItemsIndices.Size && index == NULL; i++)
+        if (g.ItemsIndices[i]->Items == items_separated_by_zeros)
+            index = g.ItemsIndices[i];
+
+    bool rebuild = true;
+    if (index)
+    {
+        const int len = index->Length;
+        if (items_separated_by_zeros[len] == 0 && (len == 0 || items_separated_by_zeros[len-1] == 0))
+            rebuild = popup_may_be_open && index->LastFrameValidated < g.FrameCount - 1 && !ItemsIndexMatches(index, items_separated_by_zeros);
+    }
+    else
+    {
+        // Reuse an index that wasn't used during the previous frame
+        for (int i = 0; i < g.ItemsIndices.Size && index == NULL; i++)
+            if (g.ItemsIndices[i]->LastFrameUsed < g.FrameCount - 1)
+                index = g.ItemsIndices[i];
+        if (index == NULL)
+        {
+            index = (ImGuiItemsIndex*)ImGui::MemAlloc(sizeof(ImGuiItemsIndex));
+            IM_PLACEMENT_NEW(index) ImGuiItemsIndex();
+            g.ItemsIndices.push_back(index);
+        }
+        index->Items = items_separated_by_zeros;
+    }
+
+    if (rebuild)
+    {
+        index->Offsets.resize(0);
+        const char* p = items_separated_by_zeros;
+        while (*p)
+        {
+            index->Offsets.push_back((int)(p - items_separated_by_zeros));
+            p += strlen(p) + 1;
+        }
+        index->Length = (int)(p - items_separated_by_zeros);
+    }
+    index->LastFrameUsed = g.FrameCount;
+    if (popup_may_be_open)
+        index->LastFrameValidated = g.FrameCount;
+    return index;
+}
+
+static bool Items_SingleStringGetter(void* data, int idx, const char** out_text)
+{
+    const ImGuiItemsIndex* index = (const ImGuiItemsIndex*)data;
+    if (idx < 0 || idx >= index->Offsets.Size)
         return false;
     if (out_text)
-        *out_text = p;
+        *out_text = index->Items + index->Offsets[idx];
     return true;
 }
 
@@ -8414,14 +10295,14 @@ bool ImGui::Combo(const char* label, int* current_item, const char** items, int
 // Combo box helper allowing to pass all items in a single string.
 bool ImGui::Combo(const char* label, int* current_item, const char* items_separated_by_zeros, int height_in_items)
 {
-    int items_count = 0;
-    const char* p = items_separated_by_zeros;       // FIXME-OPT: Avoid computing this, or at least only when combo is open
-    while (*p)
-    {
-        p += strlen(p) + 1;
-        items_count++;
-    }
-    bool value_changed = Combo(label, current_item, Items_SingleStringGetter, (void*)items_separated_by_zeros, items_count, height_in_items);
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    // The popup opens on a mouse click and displays the items on the same frame
+    ImGuiContext& g = *GImGui;
+    ImGuiItemsIndex* index = GetItemsIndex(items_separated_by_zeros, g.IO.MouseClicked[0] || IsPopupOpen(window->GetID(label)));
+    bool value_changed = Combo(label, current_item, Items_SingleStringGetter, (void*)index, index->Offsets.Size, height_in_items);
     return value_changed;
 }
 
@@ -8507,25 +10388,55 @@ bool ImGui::Combo(const char* label, int* current_item, bool (*items_getter)(voi
         const ImGuiWindowFlags flags = ImGuiWindowFlags_ComboBox | ((window->Flags & ImGuiWindowFlags_ShowBorders) ? ImGuiWindowFlags_ShowBorders : 0);
         if (BeginPopupEx(label, flags))
         {
-            // Display items
-            Spacing();
-            for (int i = 0; i < items_count; i++)
+            int scroll_to_item = popup_opened_now ? *current_item : -1;
+
+            // Type-ahead: select the first item starting with the text typed so far
+            if (popup_opened_now)
+                g.TypeAheadBuf[0] = 0;
+            if (g.IO.ComboTypeAhead && g.InputCharacters.Size > 0 && g.InputCharacters[0])
             {
-                PushID((void*)(intptr_t)i);
-                const bool item_selected = (i == *current_item);
-                const char* item_text;
-                if (!items_getter(data, i, &item_text))
-                    item_text = "*Unknown item*";
-                if (Selectable(item_text, item_selected))
+                if (g.Time - g.TypeAheadTime > 1.0f)
+                    g.TypeAheadBuf[0] = 0;
+                g.TypeAheadTime = g.Time;
+                const int buf_len = (int)strlen(g.TypeAheadBuf);
+                ImTextStrToUtf8(g.TypeAheadBuf + buf_len, IM_ARRAYSIZE(g.TypeAheadBuf) - buf_len, g.InputCharacters.Data, NULL);
+                const int prefix_len = (int)strlen(g.TypeAheadBuf);
+                for (int i = 0; i < items_count; i++)
                 {
-                    SetActiveID(0);
-                    value_changed = true;
-                    *current_item = i;
+                    const char* item_text;
+                    if (items_getter(data, i, &item_text) && ImStrnicmp(item_text, g.TypeAheadBuf, prefix_len) == 0)
+                    {
+                        if (*current_item != i)
+                            value_changed = true;
+                        *current_item = scroll_to_item = i;
+                        break;
+                    }
                 }
-                if (item_selected && popup_opened_now)
-                    SetScrollHere();
-                PopID();
             }
+
+            // Display items. They all have the same height so only the visible ones are submitted.
+            Spacing();
+            ImGuiWindow* popup_window = GetCurrentWindow();
+            const float item_height = GetTextLineHeightWithSpacing();
+            if (scroll_to_item >= 0 && scroll_to_item < items_count)
+                SetScrollFromPosY(popup_window->DC.CursorPos.y - popup_window->Pos.y + scroll_to_item * item_height + g.FontSize * 0.5f);
+            ImGuiListClipper clipper(items_count, item_height);
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                {
+                    PushID((void*)(intptr_t)i);
+                    const bool item_selected = (i == *current_item);
+                    const char* item_text;
+                    if (!items_getter(data, i, &item_text))
+                        item_text = "*Unknown item*";
+                    if (Selectable(item_text, item_selected))
+                    {
+                        SetActiveID(0);
+                        value_changed = true;
+                        *current_item = i;
+                    }
+                    PopID();
+                }
             EndPopup();
         }
         PopStyleVar();
@@ -9488,6 +11399,321 @@ void ImGui::Columns(int columns_count, const char* id, bool border)
     }
 }
 
+static ImGuiTable* FindOrCreateTable(ImGuiID id)
+{
+    ImGuiContext& g = *GImGui;
+    for (int i = 0; i != g.Tables.Size; i++)
+        if (g.Tables[i]->ID == id)
+            return g.Tables[i];
+    ImGuiTable* table = (ImGuiTable*)ImGui::MemAlloc(sizeof(ImGuiTable));
+    IM_PLACEMENT_NEW(table) ImGuiTable();
+    table->ID = id;
+    g.Tables.push_back(table);
+    return table;
+}
+
+// Screen position of the left side of a column. Frozen columns don't scroll horizontally.
+static float TableGetColumnX(const ImGuiTable* table, int column_n)
+{
+    const ImGuiWindow* window = table->InnerWindow;
+    const float x = window->Pos.x + table->ColumnsOffset[column_n];
+    return (column_n < table->FrozenColumns) ? x : x - window->Scroll.x;
+}
+
+// Horizontal range where the frozen or the scrolling columns are displayed
+static ImRect TableGetColumnsRegion(const ImGuiTable* table, bool frozen)
+{
+    const float frozen_x = ImMin(table->ViewRect.Min.x + table->ColumnsOffset[table->FrozenColumns], table->ViewRect.Max.x);
+    return frozen ? ImRect(table->ViewRect.Min.x, -FLT_MAX, frozen_x, +FLT_MAX) : ImRect(frozen_x, -FLT_MAX, table->ViewRect.Max.x, +FLT_MAX);
+}
+
+static void TableUpdateLayout(ImGuiTable* table)
+{
+    ImGuiContext& g = *GImGui;
+    if (table->ColumnsOffsetDirty)
+    {
+        const float default_width = (float)(int)(g.FontSize * 8.0f);
+        float x = 0.0f;
+        for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
+        {
+            table->ColumnsOffset[column_n] = x;
+            x += (table->ColumnsWidth[column_n] >= 0.0f) ? table->ColumnsWidth[column_n] : default_width;
+        }
+        table->ColumnsOffset[table->ColumnsCount] = x;
+        table->ColumnsOffsetDirty = false;
+    }
+
+    // Columns in view. Offsets are sorted so we can binary search the first and last scrolling columns.
+    const ImGuiWindow* window = table->InnerWindow;
+    const float view_w = table->ViewRect.GetWidth();
+    int n = 0;
+    while (n < table->FrozenColumns && table->ColumnsOffset[n] < view_w)
+        n++;
+    table->FrozenColumnsVisible = n;
+
+    const float frozen_w = table->ColumnsOffset[table->FrozenColumns];
+    const float x_min = window->Scroll.x + frozen_w;
+    const float x_max = window->Scroll.x + view_w;
+    int lo = table->FrozenColumns, hi = table->ColumnsCount;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (table->ColumnsOffset[mid + 1] > x_min) hi = mid; else lo = mid + 1;
+    }
+    table->ColumnsVisibleStart = lo;
+    hi = table->ColumnsCount;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (table->ColumnsOffset[mid] >= x_max) hi = mid; else lo = mid + 1;
+    }
+    table->ColumnsVisibleEnd = (frozen_w < view_w) ? lo : table->ColumnsVisibleStart;
+
+    // Rows in view. The scroll position is a float like for any window, so past 2^24 pixels of contents (~730k rows of the default 23 pixels) it is rounded to
+    // 2 pixels or more. The row offset is computed in double so the rows still line up exactly with that scroll position instead of adding their own rounding.
+    const double scroll_y = window->Scroll.y;
+    const float rows_view_h = table->ViewRect.GetHeight() - table->HeaderHeight;
+    table->RowsVisibleStart = ImClamp((int)(scroll_y / table->RowHeight), 0, table->RowsCount);
+    table->RowsVisibleEnd = (rows_view_h > 0.0f) ? ImClamp((int)((scroll_y + rows_view_h) / table->RowHeight) + 1, table->RowsVisibleStart, table->RowsCount) : table->RowsVisibleStart;
+    table->RowsOriginY = table->ViewRect.Min.y + table->HeaderHeight + (float)((double)table->RowsVisibleStart * table->RowHeight - scroll_y);
+}
+
+bool ImGui::BeginTable(const char* str_id, int columns_count, int rows_count, int frozen_columns, const ImVec2& size, ImGuiTableFlags flags)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = GetCurrentWindow();
+    IM_ASSERT(columns_count >= 1 && rows_count >= 0 && frozen_columns >= 0 && frozen_columns <= columns_count);
+    if (window->SkipItems)
+        return false;
+
+    // No border on the child window so it has no padding, we draw the frame ourselves in EndTable()
+    const ImGuiID id = window->GetID(str_id);
+    if (!BeginChild(id, size, false, ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        EndChild();
+        return false;
+    }
+
+    ImGuiTable* table = FindOrCreateTable(id);
+    if (table->ColumnsCount != columns_count)
+    {
+        table->ColumnsCount = columns_count;
+        table->ColumnsWidth.resize(columns_count);
+        for (int column_n = 0; column_n < columns_count; column_n++)
+            table->ColumnsWidth[column_n] = -1.0f;
+        table->ColumnsOffset.resize(columns_count + 1);
+        table->ColumnsOffsetDirty = true;
+    }
+    window = g.CurrentWindow;
+    table->Flags = flags;
+    table->RowsCount = rows_count;
+    table->FrozenColumns = frozen_columns;
+    table->InnerWindow = window;
+    table->ParentTable = g.CurrentTable;
+    table->ViewRect = ImRect(window->Pos, window->Pos + window->Size - window->ScrollbarSizes);
+    table->RowHeight = g.FontSize + g.Style.FramePadding.y * 2.0f + g.Style.ItemSpacing.y;
+    table->HeaderHeight = (flags & ImGuiTableFlags_NoHeader) ? 0.0f : table->RowHeight;
+    table->SetupColumn = 0;
+    table->CellColumn = -1;
+    table->CellRow = 0;
+    g.CurrentTable = table;
+    TableUpdateLayout(table);
+
+    if (table->HeaderHeight > 0.0f)
+        window->DrawList->AddRectFilled(table->ViewRect.Min, ImVec2(table->ViewRect.Max.x, table->ViewRect.Min.y + table->HeaderHeight), GetColorU32(ImGuiCol_Header));
+    return true;
+}
+
+void ImGui::TableSetupColumn(const char* label, float init_width)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && table->CellColumn == -1);    // Call after BeginTable() and before the first TableNextCell()
+    IM_ASSERT(table->SetupColumn < table->ColumnsCount);    // Called more times than the number of columns
+
+    const int column_n = table->SetupColumn++;
+    if (init_width > 0.0f && table->ColumnsWidth[column_n] < 0.0f)
+    {
+        table->ColumnsWidth[column_n] = (float)(int)init_width;
+        table->ColumnsOffsetDirty = true;
+    }
+    if (table->ColumnsOffsetDirty)
+        TableUpdateLayout(table);
+
+    // Header cell, only if in view
+    const bool frozen = column_n < table->FrozenColumns;
+    if (table->HeaderHeight <= 0.0f || (frozen ? column_n >= table->FrozenColumnsVisible : (column_n < table->ColumnsVisibleStart || column_n >= table->ColumnsVisibleEnd)))
+        return;
+
+    const ImGuiStyle& style = g.Style;
+    const float x1 = TableGetColumnX(table, column_n);
+    const float x2 = x1 + table->ColumnsOffset[column_n + 1] - table->ColumnsOffset[column_n];
+    const float y1 = table->ViewRect.Min.y;
+    const float y2 = y1 + table->HeaderHeight;
+    const ImRect region = TableGetColumnsRegion(table, frozen);
+    if (label)
+    {
+        ImRect clip_rect(x1, y1, x2 - style.FramePadding.x, y2);
+        clip_rect.Clip(region);
+        RenderTextClipped(ImVec2(x1 + style.FramePadding.x, y1), ImVec2(x2, y2), label, NULL, NULL, ImVec2(0.0f, 0.5f), &clip_rect);
+    }
+
+    // Resize by dragging the right border
+    if (!(table->Flags & ImGuiTableFlags_NoResize))
+    {
+        const ImGuiID resize_id = table->ID + 1 + ImGuiID(column_n);
+        ImRect handle_rect(x2 - 4, y1, x2 + 4, y2);
+        handle_rect.Clip(region);
+        if (handle_rect.Min.x >= handle_rect.Max.x)
+            return;
+
+        KeepAliveID(resize_id);
+        bool hovered, held;
+        ButtonBehavior(handle_rect, resize_id, &hovered, &held);
+        if (hovered || held)
+            g.MouseCursor = ImGuiMouseCursor_ResizeEW;
+        if (held)
+        {
+            if (g.ActiveIdIsJustActivated)
+                g.ActiveIdClickOffset.x -= 4;   // Store from center of border (we used a 8 wide rect for clicking)
+            const float width = ImMax(style.ColumnsMinSpacing, (float)(int)(g.IO.MousePos.x - g.ActiveIdClickOffset.x - x1));
+            if (width != x2 - x1)
+            {
+                table->ColumnsWidth[column_n] = width;
+                table->ColumnsOffsetDirty = true;   // Only offsets are rebuilt, cells are never measured
+            }
+        }
+    }
+}
+
+static void TableBeginColumn(ImGuiTable* table)
+{
+    // All visible cells of a column share a clip rectangle, so they end up in a single draw command
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = table->InnerWindow;
+    const int column_n = table->CellColumn;
+    const float x1 = TableGetColumnX(table, column_n);
+    const float x2 = x1 + table->ColumnsOffset[column_n + 1] - table->ColumnsOffset[column_n];
+    ImRect clip_rect(ImFloor(x1), table->ViewRect.Min.y + table->HeaderHeight, ImFloor(x2), table->ViewRect.Max.y);
+    clip_rect.Clip(TableGetColumnsRegion(table, column_n < table->FrozenColumns));
+    ImGui::PushClipRect(clip_rect.Min, clip_rect.Max, true);
+    window->DC.ColumnsOffsetX = (float)(int)(x1 + g.Style.FramePadding.x - window->Pos.x - window->DC.IndentX);
+    ImGui::PushItemWidth(x2 - x1 - g.Style.FramePadding.x * 2.0f);
+    ImGui::PushID(column_n);
+}
+
+static void TableEndColumn(ImGuiTable* table)
+{
+    ImGui::PopID();
+    ImGui::PopItemWidth();
+    ImGui::PopClipRect();
+    table->InnerWindow->DC.ColumnsOffsetX = 0.0f;
+}
+
+bool ImGui::TableNextCell(int* out_row, int* out_column)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL);   // Call between BeginTable() and EndTable()
+    if (table->CellColumn >= table->ColumnsCount)
+        return false;
+
+    if (table->CellColumn == -1)
+    {
+        // First cell
+        if (table->ColumnsOffsetDirty)
+            TableUpdateLayout(table);
+        table->CellColumn = (table->FrozenColumnsVisible > 0) ? 0 : table->ColumnsVisibleStart;
+        if (table->RowsVisibleStart >= table->RowsVisibleEnd || table->CellColumn >= table->ColumnsVisibleEnd)
+        {
+            table->CellColumn = table->ColumnsCount;
+            return false;
+        }
+        table->CellRow = table->RowsVisibleStart;
+        TableBeginColumn(table);
+    }
+    else
+    {
+        PopID();
+        if (++table->CellRow >= table->RowsVisibleEnd)
+        {
+            // Next visible column: frozen ones first, then the scrolling ones
+            TableEndColumn(table);
+            int column_n = table->CellColumn + 1;
+            if (column_n == table->FrozenColumnsVisible)
+                column_n = table->ColumnsVisibleStart;
+            if (column_n >= table->ColumnsVisibleEnd)
+            {
+                table->CellColumn = table->ColumnsCount;
+                return false;
+            }
+            table->CellColumn = column_n;
+            table->CellRow = table->RowsVisibleStart;
+            TableBeginColumn(table);
+        }
+    }
+
+    ImGuiWindow* window = table->InnerWindow;
+    window->DC.CursorPos.x = window->Pos.x + window->DC.IndentX + window->DC.ColumnsOffsetX;
+    window->DC.CursorPos.y = (float)(int)(table->RowsOriginY + (table->CellRow - table->RowsVisibleStart) * table->RowHeight + g.Style.ItemSpacing.y * 0.5f);
+    window->DC.CurrentLineHeight = 0.0f;
+    window->DC.CurrentLineTextBaseOffset = g.Style.FramePadding.y;     // Align text with framed widgets
+    PushID(table->CellRow);
+    *out_row = table->CellRow;
+    *out_column = table->CellColumn;
+    return true;
+}
+
+void ImGui::EndTable()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && table->InnerWindow == g.CurrentWindow);   // Mismatched BeginTable()/EndTable() calls
+    ImGuiWindow* window = table->InnerWindow;
+    if (table->CellColumn >= 0 && table->CellColumn < table->ColumnsCount)
+    {
+        // Stopped iterating before the last visible cell
+        PopID();
+        TableEndColumn(table);
+    }
+    if (table->ColumnsOffsetDirty)
+        TableUpdateLayout(table);
+
+    // Contents size, from which the inner window sizes its scrollbars. Stored as a float, see the precision note in TableUpdateLayout().
+    const float contents_h = (float)((double)table->HeaderHeight + (double)table->RowsCount * table->RowHeight);
+    window->DC.CursorMaxPos.x = window->Pos.x - window->Scroll.x + table->ColumnsOffset[table->ColumnsCount];
+    window->DC.CursorMaxPos.y = window->Pos.y + (float)((double)contents_h - window->Scroll.y);
+
+    if (!(table->Flags & ImGuiTableFlags_NoBorders))
+    {
+        const float y1 = table->ViewRect.Min.y;
+        const float y2 = ImMin(table->ViewRect.Max.y, window->DC.CursorMaxPos.y);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            const ImRect region = TableGetColumnsRegion(table, pass == 0);
+            PushClipRect(region.Min, region.Max, true);
+            const int column_begin = (pass == 0) ? 0 : table->ColumnsVisibleStart;
+            const int column_end = (pass == 0) ? table->FrozenColumnsVisible : table->ColumnsVisibleEnd;
+            for (int column_n = column_begin; column_n < column_end; column_n++)
+            {
+                const ImGuiID resize_id = table->ID + 1 + ImGuiID(column_n);
+                const ImU32 col = GetColorU32(g.ActiveId == resize_id ? ImGuiCol_ColumnActive : g.HoveredId == resize_id ? ImGuiCol_ColumnHovered : ImGuiCol_Column);
+                const float x = (float)(int)(TableGetColumnX(table, column_n) + table->ColumnsOffset[column_n + 1] - table->ColumnsOffset[column_n]) - 1.0f;
+                window->DrawList->AddLine(ImVec2(x, y1), ImVec2(x, y2), col);
+            }
+            PopClipRect();
+        }
+        if (table->HeaderHeight > 0.0f)
+            window->DrawList->AddLine(ImVec2(table->ViewRect.Min.x, y1 + table->HeaderHeight - 1.0f), ImVec2(table->ViewRect.Max.x, y1 + table->HeaderHeight - 1.0f), GetColorU32(ImGuiCol_Border));
+        PushClipRect(window->Pos, window->Pos + window->Size, false);
+        window->DrawList->AddRect(window->Pos, window->Pos + window->Size, GetColorU32(ImGuiCol_Border));
+        PopClipRect();
+    }
+
+    g.CurrentTable = table->ParentTable;
+    EndChild();
+}
+
 void ImGui::Indent(float indent_w)
 {
     ImGuiContext& g = *GImGui;
@@ -9543,7 +11769,9 @@ void ImGui::Value(const char* prefix, bool b)
 
 void ImGui::Value(const char* prefix, int v)
 {
-    Text("%s: %d", prefix, v);
+    char value_buf[16];
+    FormatScalar(value_buf, IM_ARRAYSIZE(value_buf), "%d", v);
+    Text("%s: %s", prefix, value_buf);
 }
 
 void ImGui::Value(const char* prefix, unsigned int v)
@@ -9553,16 +11781,9 @@ void ImGui::Value(const char* prefix, unsigned int v)
 
 void ImGui::Value(const char* prefix, float v, const char* float_format)
 {
-    if (float_format)
-    {
-        char fmt[64];
-        ImFormatString(fmt, IM_ARRAYSIZE(fmt), "%%s: %s", float_format);
-        Text(fmt, prefix, v);
-    }
-    else
-    {
-        Text("%s: %.3f", prefix, v);
-    }
+    char value_buf[64];
+    FormatScalar(value_buf, IM_ARRAYSIZE(value_buf), float_format ? float_format : "%.3f", v);
+    Text("%s: %s", prefix, value_buf);
 }
 
 // FIXME: May want to remove those helpers?
@@ -9597,24 +11818,32 @@ void ImGui::ValueColor(const char* prefix, ImU32 v)
 #pragma comment(lib, "user32")
 #endif
 
+// The returned text is stored in the context (instead of a static buffer) so different contexts can be used from different threads
 static const char* GetClipboardTextFn_DefaultImpl(void*)
 {
-    static ImVector<char> buf_local;
-    buf_local.clear();
+    ImGuiContext& g = *GImGui;
+    if (g.PrivateClipboard)
+    {
+        ImGui::MemFree(g.PrivateClipboard);
+        g.PrivateClipboard = NULL;
+    }
     if (!OpenClipboard(NULL))
         return NULL;
     HANDLE wbuf_handle = GetClipboardData(CF_UNICODETEXT);
     if (wbuf_handle == NULL)
+    {
+        CloseClipboard();
         return NULL;
+    }
     if (ImWchar* wbuf_global = (ImWchar*)GlobalLock(wbuf_handle))
     {
         int buf_len = ImTextCountUtf8BytesFromStr(wbuf_global, NULL) + 1;
-        buf_local.resize(buf_len);
-        ImTextStrToUtf8(buf_local.Data, buf_len, wbuf_global, NULL);
+        g.PrivateClipboard = (char*)ImGui::MemAlloc((size_t)buf_len);
+        ImTextStrToUtf8(g.PrivateClipboard, buf_len, wbuf_global, NULL);
     }
     GlobalUnlock(wbuf_handle);
     CloseClipboard();
-    return buf_local.Data;
+    return g.PrivateClipboard;
 }
 
 static void SetClipboardTextFn_DefaultImpl(void*, const char* text)
@@ -9697,7 +11926,10 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("ImGui %s", ImGui::GetVersion());
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
+        ImGui::Text("%d vertices, %d indices culled", ImGui::GetIO().MetricsRenderCulledVertices, ImGui::GetIO().MetricsRenderCulledIndices);
         ImGui::Text("%d allocations", ImGui::GetIO().MetricsAllocs);
+        const ImGuiDrawBuffersPool& pool = GImGui->DrawBuffersPool;
+        ImGui::Text("Draw buffers: %d bytes used (peak %d), %d bytes free in %d blocks", pool.UsedBytes, pool.PeakUsedBytes, pool.FreeBytes, pool.FreeBlocksCount);
         static bool show_clip_rects = true;
         ImGui::Checkbox("Show clipping rectangles when hovering a ImDrawCmd", &show_clip_rects);
         ImGui::Separator();
@@ -9706,7 +11938,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         {
             static void NodeDrawList(ImDrawList* draw_list, const char* label)
             {
-                bool node_open = ImGui::TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->IdxBuffer.Size, draw_list->CmdBuffer.Size);
+                bool node_open = ImGui::TreeNode(draw_list, "%s: '%s' %d vtx, %d indices, %d cmds", label, draw_list->_OwnerName ? draw_list->_OwnerName : "", draw_list->VtxBuffer.Size, draw_list->GetIdxCount(), draw_list->CmdBuffer.Size);
                 if (draw_list == ImGui::GetWindowDrawList())
                 {
                     ImGui::SameLine();
@@ -9719,6 +11951,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
 
                 ImDrawList* overlay_draw_list = &GImGui->OverlayDrawList;   // Render additional visuals into the top-most draw list
                 overlay_draw_list->PushClipRectFullScreen();
+                draw_list->MergeIdxSpans();     // Gather indices in IdxBuffer to browse them, the list stays valid
                 int elem_offset = 0;
                 for (const ImDrawCmd* pcmd = draw_list->CmdBuffer.begin(); pcmd < draw_list->CmdBuffer.end(); elem_offset += pcmd->ElemCount, pcmd++)
                 {
@@ -9749,8 +11982,9 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                             for (int n = 0; n < 3; n++, vtx_i++)
                             {
                                 ImDrawVert& v = draw_list->VtxBuffer[idx_buffer ? idx_buffer[vtx_i] : vtx_i];
-                                triangles_pos[n] = v.pos;
-                                buf_p += sprintf(buf_p, "%s %04d { pos = (%8.2f,%8.2f), uv = (%.6f,%.6f), col = %08X }\n", (n == 0) ? "vtx" : "   ", vtx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                                const ImVec2 pos = v.pos, uv = v.uv;
+                                triangles_pos[n] = pos;
+                                buf_p += sprintf(buf_p, "%s %04d { pos = (%8.2f,%8.2f), uv = (%.6f,%.6f), col = %08X }\n", (n == 0) ? "vtx" : "   ", vtx_i, pos.x, pos.y, uv.x, uv.y, v.col);
                             }
                             ImGui::Selectable(buf, false);
                             if (ImGui::IsItemHovered())
@@ -9778,15 +12012,21 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                 NodeDrawList(window->DrawList, "DrawList");
                 ImGui::BulletText("Pos: (%.1f,%.1f)", window->Pos.x, window->Pos.y);
                 ImGui::BulletText("Size: (%.1f,%.1f), SizeContents (%.1f,%.1f)", window->Size.x, window->Size.y, window->SizeContents.x, window->SizeContents.y);
+                ImGui::BulletText("Layout stable for %d frames", window->LayoutStableFrames);
                 ImGui::BulletText("Scroll: (%.2f,%.2f)", window->Scroll.x, window->Scroll.y);
                 if (window->RootWindow != window) NodeWindow(window->RootWindow, "RootWindow");
                 if (window->DC.ChildWindows.Size > 0) NodeWindows(window->DC.ChildWindows, "ChildWindows");
                 ImGui::BulletText("Storage: %d bytes", window->StateStorage.Data.Size * (int)sizeof(ImGuiStorage::Pair));
+                ImGui::BulletText("Memory: %d bytes%s, inactive for %.1f sec", (int)CalcWindowMemoryUsage(window), window->MemoryCompacted ? " (compacted)" : "", window->Active ? 0.0f : (float)GImGui->Time - window->LastTimeActive);
                 ImGui::TreePop();
             }
         };
 
         ImGuiContext& g = *GImGui;                // Access private state
+        size_t windows_memory = 0;
+        for (int i = 0; i < g.Windows.Size; i++)
+            windows_memory += CalcWindowMemoryUsage(g.Windows[i]);
+        ImGui::Text("%d windows, %d bytes", g.Windows.Size, (int)windows_memory);
         Funcs::NodeWindows(g.Windows, "Windows");
         if (ImGui::TreeNode("DrawList", "Active DrawLists (%d)", g.RenderDrawLists[0].Size))
         {
@@ -9803,6 +12043,14 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             }
             ImGui::TreePop();
         }
+        if (ImGui::TreeNode("TextLayoutCache", "Text Layout Cache (%d/%d)", g.TextLayoutCache.Layouts.Size, g.IO.TextLayoutCacheSize))
+        {
+            const ImGuiTextLayoutCache& cache = g.TextLayoutCache;
+            const int lookups = cache.LastFrameHits + cache.LastFrameMisses;
+            ImGui::Text("Last frame: %d lookups, %d hits, %d misses (%.1f%% hit rate)", lookups, cache.LastFrameHits, cache.LastFrameMisses, lookups > 0 ? cache.LastFrameHits * 100.0f / lookups : 0.0f);
+            ImGui::Text("%d glyph quads cached, %d bytes of text", cache.QuadsDataUsed, cache.TextDataUsed);
+            ImGui::TreePop();
+        }
         if (ImGui::TreeNode("Basic state"))
         {
             ImGui::Text("FocusedWindow: '%s'", g.FocusedWindow ? g.FocusedWindow->Name : "NULL");
@@ -46,7 +46,7 @@ struct ImDrawChannel;               // Temporary storage for outputting drawing
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call)
 struct ImDrawData;                  // All draw command lists required to render the frame
 struct ImDrawList;                  // A single draw command list (generally one per window)
-struct ImDrawVert;                  // A single vertex (20 bytes by default, override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+struct ImDrawVert;                  // A single vertex (20 bytes by default, 12 bytes with IMGUI_USE_COMPACT_DRAWVERT, override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF font loader
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
@@ -55,11 +55,14 @@ struct ImGuiIO;                     // Main configuration and I/O between your a
 struct ImGuiOnceUponAFrame;         // Simple helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
 struct ImGuiStorage;                // Simple custom key value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
+struct ImGuiStyleSnapshot;          // Pre-baked copy of a style, applied as a whole with PushStyleSnapshot()
 struct ImGuiTextFilter;             // Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 struct ImGuiTextBuffer;             // Text buffer for logging/accumulating text
+struct ImGuiTextChunkedBuffer;      // Append-only text buffer for large logs, stored in fixed-size blocks with a line index
 struct ImGuiTextEditCallbackData;   // Shared state of ImGui::InputText() when using custom ImGuiTextEditCallback (rare/advanced use)
 struct ImGuiSizeConstraintCallbackData;// Structure used to constraint window size in custom ways when using custom ImGuiSizeConstraintCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiTreeClipper;            // Helper to manually clip large tree, keeping a flattened list of the visible nodes
 struct ImGuiContext;                // ImGui context (opaque)
 
 // Typedefs and Enumerations (declared as int for compatibility and to not pollute the top of this file)
@@ -77,6 +80,7 @@ typedef int ImGuiSetCond;           // condition flags for Set*()           // e
 typedef int ImGuiInputTextFlags;    // flags for InputText*()               // enum ImGuiInputTextFlags_
 typedef int ImGuiSelectableFlags;   // flags for Selectable()               // enum ImGuiSelectableFlags_
 typedef int ImGuiTreeNodeFlags;     // flags for TreeNode*(), Collapsing*() // enum ImGuiTreeNodeFlags_
+typedef int ImGuiTableFlags;        // flags for BeginTable()               // enum ImGuiTableFlags_
 typedef int (*ImGuiTextEditCallback)(ImGuiTextEditCallbackData *data);
 typedef void (*ImGuiSizeConstraintCallback)(ImGuiSizeConstraintCallbackData* data);
 
@@ -178,6 +182,8 @@ namespace ImGui
     IMGUI_API void          PushStyleVar(ImGuiStyleVar idx, float val);
     IMGUI_API void          PushStyleVar(ImGuiStyleVar idx, const ImVec2& val);
     IMGUI_API void          PopStyleVar(int count = 1);
+    IMGUI_API void          PushStyleSnapshot(const ImGuiStyleSnapshot& snapshot);             // replace the whole style with a pre-baked one. cheaper than many PushStyleColor()/PushStyleVar() calls to apply a theme
+    IMGUI_API void          PopStyleSnapshot(int count = 1);
     IMGUI_API ImFont*       GetFont();                                                          // get current font
     IMGUI_API float         GetFontSize();                                                      // get current font size (= height in pixels) of current font with current scale applied
     IMGUI_API ImVec2        GetFontTexUvWhitePixel();                                           // get UV coordinate for a while pixel, useful to draw custom shapes via the ImDrawList API
@@ -229,6 +235,15 @@ namespace ImGui
     IMGUI_API float         GetColumnWidth(int column_index = -1);                              // column width (== GetColumnOffset(GetColumnIndex()+1) - GetColumnOffset(GetColumnOffset())
     IMGUI_API int           GetColumnsCount();                                                  // number of columns (what was passed to Columns())
 
+    // Tables
+    // Scrolling grid for large data sets: only the visible cells are submitted, so the cost of a frame doesn't depend on rows_count/columns_count. The header row and the first 'frozen_columns' columns stay in place while scrolling.
+    // Column widths are persistent and can be resized by dragging the header borders. Rows all have the same height.
+    // Scrolling uses float pixels: beyond 2^24 pixels of rows (~730k rows at the default height) the scroll position has a granularity of 2 pixels or more.
+    IMGUI_API bool          BeginTable(const char* str_id, int columns_count, int rows_count, int frozen_columns = 0, const ImVec2& size = ImVec2(0,0), ImGuiTableFlags flags = 0); // only call EndTable() if BeginTable() returns true!
+    IMGUI_API void          TableSetupColumn(const char* label, float init_width = 0.0f);       // optionally call once per column, in order, before the first TableNextCell(): set header label and initial width. cheap for columns out of view.
+    IMGUI_API bool          TableNextCell(int* out_row, int* out_column);                       // move to the next visible cell and return true, or return false once all visible cells have been submitted. cells are visited column by column so their draw calls get batched.
+    IMGUI_API void          EndTable();
+
     // ID scopes
     // If you are creating widgets in a loop you most likely want to push a unique identifier so ImGui can differentiate them.
     // You can also use the "##foobar" syntax within widget label to distinguish them from each others. Read "A primer on the use of labels/IDs" in the FAQ for more details.
@@ -266,7 +281,7 @@ namespace ImGui
     IMGUI_API bool          RadioButton(const char* label, bool active);
     IMGUI_API bool          RadioButton(const char* label, int* v, int v_button);
     IMGUI_API bool          Combo(const char* label, int* current_item, const char** items, int items_count, int height_in_items = -1);
-    IMGUI_API bool          Combo(const char* label, int* current_item, const char* items_separated_by_zeros, int height_in_items = -1);      // separate items with \0, end item-list with \0\0
+    IMGUI_API bool          Combo(const char* label, int* current_item, const char* items_separated_by_zeros, int height_in_items = -1);      // separate items with \0, end item-list with \0\0. the item offsets are cached per string pointer: the string length is checked every frame, the whole string when the popup opens
     IMGUI_API bool          Combo(const char* label, int* current_item, bool (*items_getter)(void* data, int idx, const char** out_text), void* data, int items_count, int height_in_items = -1);
     IMGUI_API bool          ColorButton(const ImVec4& col, bool small_height = false, bool outline_border = true);
     IMGUI_API bool          ColorEdit3(const char* label, float col[3]);                            // Hint: 'float col[3]' function argument is same as 'float* col'. You can pass address of first element out of a contiguous set, e.g. &myvector.x
@@ -456,6 +471,7 @@ namespace ImGui
 
     // Internal context access - if you want to use multiple context, share context between modules (e.g. DLL). There is a default context created and active by default.
     // All contexts share a same ImFontAtlas by default. If you want different font atlas, you can new() them and overwrite the GetIO().Fonts variable of an ImGui context.
+    // With IMGUI_THREAD_LOCAL_CONTEXT defined in imconfig.h the current context is per-thread, and different threads may use different contexts concurrently (build the shared font atlas first).
     IMGUI_API const char*   GetVersion();
     IMGUI_API ImGuiContext* CreateContext(void* (*malloc_fn)(size_t) = NULL, void (*free_fn)(void*) = NULL);
     IMGUI_API void          DestroyContext(ImGuiContext* ctx);
@@ -557,6 +573,15 @@ enum ImGuiSelectableFlags_
     ImGuiSelectableFlags_AllowDoubleClick   = 1 << 2    // Generate press events on double clicks too
 };
 
+// Flags for ImGui::BeginTable()
+enum ImGuiTableFlags_
+{
+    // Default: 0
+    ImGuiTableFlags_NoHeader                = 1 << 0,   // Don't display the header row
+    ImGuiTableFlags_NoResize                = 1 << 1,   // Disable resizing columns by dragging the header borders
+    ImGuiTableFlags_NoBorders               = 1 << 2    // Don't draw the frame and column borders
+};
+
 // User fill ImGuiIO.KeyMap[] array with indices into the ImGuiIO.KeysDown[512] array
 enum ImGuiKey_
 {
@@ -715,6 +740,18 @@ struct ImGuiStyle
     IMGUI_API ImGuiStyle();
 };
 
+// Pre-baked copy of a style, for PushStyleSnapshot()/PopStyleSnapshot().
+// The packed colors are computed once here instead of on every GetColorU32() call. Call Bake() again after modifying Style.
+struct ImGuiStyleSnapshot
+{
+    ImGuiStyle  Style;
+    ImU32       ColorsU32[ImGuiCol_COUNT];  // Style.Colors[] packed, Style.Alpha is applied by GetColorU32()
+
+    ImGuiStyleSnapshot()                        { Bake(); }
+    ImGuiStyleSnapshot(const ImGuiStyle& style) { Style = style; Bake(); }
+    IMGUI_API void  Bake();
+};
+
 // This is where your app communicate with ImGui. Access via ImGui::GetIO().
 // Read 'Programmer guide' section in .cpp file for general usage.
 struct ImGuiIO
@@ -726,6 +763,8 @@ struct ImGuiIO
     ImVec2        DisplaySize;              // <unset>              // Display size, in pixels. For clamping windows positions.
     float         DeltaTime;                // = 1.0f/60.0f         // Time elapsed since last frame, in seconds.
     float         IniSavingRate;            // = 5.0f               // Maximum time between saving positions/sizes to .ini file, in seconds.
+    float         WindowsCompactTimer;      // = 60.0f              // Release draw buffers and temporary memory of windows that haven't been submitted for this many seconds. -1.0f to disable.
+    float         WindowsDestroyTimer;      // = -1.0f              // Destroy windows that haven't been submitted for this many seconds, keeping their .ini settings (state such as scrolling and tree nodes is lost). -1.0f to disable.
     const char*   IniFilename;              // = "imgui.ini"        // Path to .ini file. NULL to disable .ini saving.
     const char*   LogFilename;              // = "imgui_log.txt"    // Path to .log file (default parameter to ImGui::LogToFile when no file is specified).
     float         MouseDoubleClickTime;     // = 0.30f              // Time for a double-click, in seconds.
@@ -745,6 +784,12 @@ struct ImGuiIO
     ImVec2        DisplayVisibleMax;        // <unset> (0.0f,0.0f)  // If the values are the same, we defaults to Min=(0.0f) and Max=DisplaySize
 
     // Advanced/subtle behaviors
+    bool          DrawListsUseIdxSpans;     // = false              // Merge draw channels (used by Columns) without copying their indices. Your renderer needs to handle ImDrawList::IdxSpans (see opengl3_example).
+    bool          DrawDataUseArenas;        // = false              // Copy the vertices and indices of all draw lists into a single vertex buffer and a single index buffer when rendering (ImDrawData::VtxArena/IdxArena), so your renderer can upload them at once. Leave it off if your renderer copies the draw lists into mapped memory anyway (see vulkan_example), the arenas would be an extra copy.
+    int           DrawBuffersPoolDecayFrames; // = 120              // Windows draw lists borrow their vertex/index buffers from a pool shared by the context and give them back every frame. Free buffers which haven't been borrowed for this many frames are released. -1 to disable (each draw list keeps its own buffers).
+    bool          ComboTypeAhead;           // = true               // Typing while a Combo() popup is open selects the first item starting with the typed text (case insensitive).
+    bool          InputEventsTrickle;       // = true               // When applying input events, stop at an event which would overwrite a change made by an earlier event of the same frame (same button/key pressed then released, mouse moved after a click, key after text...) and keep the rest for the next frames.
+    int           TextLayoutCacheSize;      // = 0                  // Number of text layouts (size + glyph quads of short labels) to keep across frames, saving text measurement and glyph lookups for text submitted every frame. 0 to disable. Cleared when the font atlas texture changes.
     bool          OSXBehaviors;             // = defined(__APPLE__) // OS X style: Text editing cursor movement using Alt instead of Ctrl, Shortcuts using Cmd/Super instead of Ctrl, Line/Text Start and End using Cmd+Arrows instead of Home/End, Double click selects by word instead of selecting whole text, Multi-selection in lists uses Cmd/Super instead of Ctrl
 
     //------------------------------------------------------------------
@@ -785,12 +830,21 @@ struct ImGuiIO
     bool        KeyAlt;                     // Keyboard modifier pressed: Alt
     bool        KeySuper;                   // Keyboard modifier pressed: Cmd/Super/Windows
     bool        KeysDown[512];              // Keyboard keys that are pressed (in whatever storage order you naturally have access to keyboard data)
-    ImWchar     InputCharacters[16+1];      // List of characters input (translated by user from keypress+keyboard state). Fill using AddInputCharacter() helper.
+    ImWchar     InputCharacters[16+1];      // List of characters input (translated by user from keypress+keyboard state). Fill using AddInputCharacter() helper. After NewFrame() holds the first characters of the frame, InputText() uses all of them.
 
     // Functions
-    IMGUI_API void AddInputCharacter(ImWchar c);                        // Helper to add a new character into InputCharacters[]
-    IMGUI_API void AddInputCharactersUTF8(const char* utf8_chars);      // Helper to add new characters into InputCharacters[] from an UTF-8 string
-    inline void    ClearInputCharacters() { InputCharacters[0] = 0; }   // Helper to clear the text input buffer
+    IMGUI_API void AddInputCharacter(ImWchar c);                        // Queue a character input, there is no limit on the number of characters per frame
+    IMGUI_API void AddInputCharactersUTF8(const char* utf8_chars);      // Queue characters input from an UTF-8 string
+    IMGUI_API void ClearInputCharacters();                              // Clear the text input buffer and queued characters
+
+    // Input events: alternative to writing the fields above. Events are queued and applied in order by NewFrame(), so a button or key pressed and released within a frame isn't lost.
+    // With InputEventsTrickle, an event which would overwrite a change made earlier in the same frame is kept for the next frame (see InputEventsTrickle).
+    // 'time' is an optional timestamp in seconds in your own clock (e.g. from your OS event), used to detect double-clicks from the actual click times when the framerate is low.
+    IMGUI_API void AddMousePosEvent(float x, float y, double time = -1.0);
+    IMGUI_API void AddMouseButtonEvent(int button, bool down, double time = -1.0);  // button: 0..4, same as MouseDown[]
+    IMGUI_API void AddMouseWheelEvent(float wheel, double time = -1.0);
+    IMGUI_API void AddKeyEvent(int key_index, bool down, double time = -1.0);       // key_index: index in KeysDown[], as used in KeyMap[]
+    IMGUI_API void AddKeyModsEvent(bool ctrl, bool shift, bool alt, bool super, double time = -1.0);
 
     //------------------------------------------------------------------
     // Output - Retrieve after calling NewFrame(), you can use them to discard inputs or hide them from the rest of your application
@@ -803,6 +857,9 @@ struct ImGuiIO
     int         MetricsAllocs;              // Number of active memory allocations
     int         MetricsRenderVertices;      // Vertices output during last call to Render()
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderCulledVertices; // Vertices of draw lists discarded during last call to Render(), because they were outside of the display or behind an opaque window
+    int         MetricsRenderCulledIndices; // Indices discarded during last call to Render(), including those of draw commands removed from draw lists which are kept
+    int         MetricsDrawBuffersPoolBytes; // Memory held by the draw buffers pool: buffers of the draw lists rendered during last call to Render() + free buffers (see DrawBuffersPoolDecayFrames)
     int         MetricsActiveWindows;       // Number of visible windows (exclude child windows)
 
     //------------------------------------------------------------------
@@ -925,6 +982,17 @@ struct ImGuiTextFilter
     ImVector<TextRange> Filters;
     int                 CountGrep;
 
+    // [Internal] Compiled matcher, rebuilt by Build(). All filters are matched in a single pass over the text (Aho-Corasick automaton over case-folded patterns).
+    unsigned char       CharClass[256];     // Byte -> character class. Class 0 is for bytes which don't appear in any filter.
+    int                 CharClassCount;
+    ImVector<unsigned short> StateNext;     // [state * CharClassCount + class] -> next state. State 0 is the root.
+    ImVector<short>     StateFilterIdx;     // Lowest index into Filters[] matched when reaching a state, or -1
+
+    // [Internal] Cache for PassFilterLines(), invalidated by Build()
+    ImVector<int>       LinesPassed;
+    const void*         LinesSrc;
+    int                 LinesCount;
+
     ImGuiTextFilter(const char* default_filter = "");
     ~ImGuiTextFilter() {}
     void                Clear() { InputBuf[0] = 0; Build(); }
@@ -932,6 +1000,11 @@ struct ImGuiTextFilter
     bool                PassFilter(const char* text, const char* text_end = NULL) const;
     bool                IsActive() const { return !Filters.empty(); }
     IMGUI_API void      Build();
+
+    // Bulk filtering: return the indices of the lines passing the filter. Results are cached until the filter changes, lines appended since the last call are filtered incrementally.
+    // If you modify or remove existing lines, call Build() to invalidate the cache.
+    IMGUI_API const ImVector<int>& PassFilterLines(const char* const* lines, int lines_count);
+    IMGUI_API const ImVector<int>& PassFilterLines(bool (*lines_getter)(void* data, int idx, const char** out_text, const char** out_text_end), void* data, int lines_count);
 };
 
 // Helper: Text buffer for logging/accumulating text
@@ -951,6 +1024,44 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendv(const char* fmt, va_list args);
 };
 
+// Helper: Append-only text buffer for high-volume logs
+// Text is stored in blocks of ChunkSize bytes which are never reallocated, so appending never copies old content (unlike ImGuiTextBuffer which grows a single contiguous buffer).
+// Complete lines (terminated by '\n') are indexed and can be accessed randomly, e.g. to only display the visible lines using ImGuiListClipper:
+//     ImGuiListClipper clipper(buf.line_count());
+//     while (clipper.Step())
+//         for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//         {
+//             const char* line_end;
+//             const char* line = buf.get_line(i, &line_end);
+//             ImGui::TextUnformatted(line, line_end);
+//         }
+struct ImGuiTextChunkedBuffer
+{
+    struct Line
+    {
+        const char*     b;
+        const char*     e;                  // Points to the '\n' terminating the line
+    };
+
+    int                 ChunkSize;          // Size of each block. A line bigger than this gets a block of its own.
+    ImVector<char*>     Chunks;
+    ImVector<Line>      Lines;              // Complete lines. Text after the last '\n' is not indexed until its line is terminated.
+    char*               LineBegin;          // Beginning of the line being appended, in the last chunk
+    char*               WritePtr;           // Write position in the last chunk
+    char*               WriteEnd;           // End of the last chunk
+    int                 TextSize;
+
+    ImGuiTextChunkedBuffer(int chunk_size = 64*1024) { ChunkSize = chunk_size; LineBegin = WritePtr = WriteEnd = NULL; TextSize = 0; }
+    ~ImGuiTextChunkedBuffer()                       { clear(); }
+    int                 size() const                { return TextSize; }
+    bool                empty() const               { return TextSize == 0; }
+    int                 line_count() const          { return Lines.Size; }
+    const char*         get_line(int idx, const char** out_line_end) const { const Line& line = Lines[idx]; if (out_line_end) *out_line_end = line.e; return line.b; }
+    IMGUI_API void      clear();
+    IMGUI_API void      append(const char* fmt, ...) IM_PRINTFARGS(2);
+    IMGUI_API void      appendv(const char* fmt, va_list args);
+};
+
 // Helper: Simple Key->value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1), store color edit options.
@@ -1027,6 +1138,7 @@ struct ImGuiTextEditCallbackData
 
 // Resizing callback data to apply custom constraint. As enabled by SetNextWindowSizeConstraints(). Callback is called during the next Begin().
 // NB: For basic min/max size constraint on each axis you don't need to use the callback! The SetNextWindowSizeConstraints() parameters are enough.
+// NB: The callback is skipped when the window layout is stable (same contents size, size, constraints, callback, user data and position as last frame), so the result should only depend on those.
 struct ImGuiSizeConstraintCallbackData
 {
     void*   UserData;       // Read-only.   What user passed to SetNextWindowSizeConstraints()
@@ -1105,6 +1217,52 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Helper: Manually clip a large tree, submitting only the rows that are in view.
+// The hierarchy is provided by a callback filling the children of a node. Nodes are identified by your own integers (e.g. indices in your array), -1 being the (hidden) root.
+// The helper keeps a flattened list of the visible rows (nodes whose parents are all open). It is built once then updated incrementally when a node is opened or closed, so the cost of a frame doesn't depend on the size of the tree.
+// Open state is stored in the window storage like TreeNode(), nodes default to closed. All rows are assumed to have the same height. Call Clear() if your hierarchy changes.
+// There is no keyboard navigation in ImGui yet: use SetNodeOpen() and ScrollToRow() to implement your own, as rows outside of the view are never submitted and SetScrollHere() can't reach them.
+// Usage:
+//     static ImGuiTreeClipper tree;                    // Persistent: holds the rows between frames
+//     tree.Begin("scene", GetChildren, &scene);        // void GetChildren(void* data, int node, ImVector<int>* out_children)
+//     while (tree.Step())
+//         for (int row = tree.DisplayStart; row < tree.DisplayEnd; row++)
+//             tree.TreeNode(row, scene.Names[tree.GetNode(row)]);
+struct ImGuiTreeClipper
+{
+    struct Row
+    {
+        int     Node;
+        int     Depth;
+        bool    HasChildren;
+        bool    Open;
+    };
+    ImVector<Row>   Rows;               // Visible rows, in display order
+    int             DisplayStart, DisplayEnd;
+    float           StartPosY;
+    float           RowHeight;          // Measured on first Step(), then updated from the rows displayed
+    int             StepNo;
+    bool            RowsValid;
+    ImGuiID         ID;
+    ImGuiStorage*   Storage;
+    void            (*ChildrenGetter)(void* data, int node, ImVector<int>* out_children);
+    void*           UserData;
+    ImVector<int>   TempChildren;
+    ImVector<Row>   TempRows;
+
+    ImGuiTreeClipper()  { DisplayStart = DisplayEnd = 0; StartPosY = RowHeight = 0.0f; StepNo = 0; RowsValid = false; ID = 0; Storage = NULL; ChildrenGetter = NULL; UserData = NULL; }
+
+    IMGUI_API void  Begin(const char* str_id, void (*children_getter)(void* data, int node, ImVector<int>* out_children), void* data); // Rows are built on first use or after Clear()
+    IMGUI_API bool  Step();                                                 // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those rows.
+    IMGUI_API bool  TreeNode(int row, const char* label, ImGuiTreeNodeFlags flags = 0); // Indent and display the node at 'row', update rows if it was opened/closed. Doesn't push on the ID stack, no TreePop() needed.
+    IMGUI_API void  SetNodeOpen(int row, bool is_open);                     // Open/close the node at 'row' and update rows
+    IMGUI_API void  ScrollToRow(int row, float center_y_ratio = 0.5f);      // Call between Begin() and the end of Step() loop. center_y_ratio: 0.0f top of row, 0.5f center, 1.0f bottom.
+    IMGUI_API int   FindRow(int node) const;                                // Return -1 if node is not visible
+    IMGUI_API void  Clear();                                                // Rows will be rebuilt from the hierarchy and storage on next Begin()
+    int             GetNode(int row) const      { return Rows[row].Node; }
+    IMGUI_API ImGuiID GetNodeID(int node) const;
+};
+
 //-----------------------------------------------------------------------------
 // Draw List
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -1134,7 +1292,38 @@ typedef unsigned short ImDrawIdx;
 #endif
 
 // Vertex layout
-#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#if defined(IMGUI_USE_COMPACT_DRAWVERT) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+// Compact vertex layout (12 bytes instead of 20) enabled by IMGUI_USE_COMPACT_DRAWVERT in imconfig.h, to reduce vertex bandwidth e.g. for remote rendering
+// - pos: signed 16-bit fixed point with IM_DRAWVERT_POS_FRAC_BITS fractional bits. The default of 2 gives 1/4 pixel steps within -8192..+8191 pixels, further positions are clamped.
+// - uv: unsigned 16-bit fixed point in 1/65536 steps, so font atlas coordinates are exact. Clamped to 0.0f..65535/65536.0f: ImDrawList::AddImage() can't repeat textures.
+// Your renderer needs to read positions and uv as non-normalized shorts, scaled by 1.0f/IM_DRAWVERT_POS_SCALE (e.g. folded in the projection matrix) and 1.0f/65536.0f.
+// Positions on the 1/4 pixel grid (rectangles, text, images) render the same as with floats, other AA edges may differ slightly. See opengl3_example.
+// Assigning or reading 'pos' and 'uv' as ImVec2 converts from/to floats.
+#ifndef IM_DRAWVERT_POS_FRAC_BITS
+#define IM_DRAWVERT_POS_FRAC_BITS   2
+#endif
+#define IM_DRAWVERT_POS_SCALE       ((float)(1 << IM_DRAWVERT_POS_FRAC_BITS))
+struct ImDrawVertPos
+{
+    signed short    x, y;
+    ImDrawVertPos&  operator=(const ImVec2& v)  { x = Quantize(v.x); y = Quantize(v.y); return *this; }
+    operator        ImVec2() const              { return ImVec2(x * (1.0f / IM_DRAWVERT_POS_SCALE), y * (1.0f / IM_DRAWVERT_POS_SCALE)); }
+    static signed short Quantize(float v)       { v = v * IM_DRAWVERT_POS_SCALE + 32768.5f; return (signed short)((int)(v < 0.0f ? 0.0f : v > 65535.0f ? 65535.0f : v) - 32768); }
+};
+struct ImDrawVertUV
+{
+    unsigned short  x, y;
+    ImDrawVertUV&   operator=(const ImVec2& v)  { x = Quantize(v.x); y = Quantize(v.y); return *this; }
+    operator        ImVec2() const              { return ImVec2(x * (1.0f / 65536.0f), y * (1.0f / 65536.0f)); }
+    static unsigned short Quantize(float v)     { v = v * 65536.0f + 0.5f; return (unsigned short)(v <= 0.0f ? 0 : v >= 65535.0f ? 65535 : (int)v); }
+};
+struct ImDrawVert
+{
+    ImDrawVertPos   pos;
+    ImDrawVertUV    uv;
+    ImU32           col;
+};
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImDrawVert
 {
     ImVec2  pos;
@@ -1143,7 +1332,7 @@ struct ImDrawVert
 };
 #else
 // You can override the vertex format layout by defining IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT in imconfig.h
-// The code expect ImVec2 pos (8 bytes), ImVec2 uv (8 bytes), ImU32 col (4 bytes), but you can re-order them or add other fields as needed to simplify integration in your engine.
+// The code expect 'pos' and 'uv' assignable from ImVec2 (and convertible to ImVec2) and ImU32 col (4 bytes), but you can re-order them or add other fields as needed to simplify integration in your engine.
 // The type has to be described within the macro (you can either declare the struct or use a typedef)
 IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT;
 #endif
@@ -1156,6 +1345,13 @@ struct ImDrawChannel
     ImVector<ImDrawIdx>     IdxBuffer;
 };
 
+// Part of the index data of a ImDrawList, when channels are merged without copying indices (see ImDrawList::IdxSpans)
+struct ImDrawIdxSpan
+{
+    const ImDrawIdx*        IdxData;
+    int                     IdxCount;
+};
+
 // Draw command list
 // This is the low-level list of polygons that ImGui functions are filling. At the end of the frame, all command lists are passed to your ImGuiIO::RenderDrawListFn function for rendering.
 // At the moment, each ImGui window contains its own ImDrawList but they could potentially be merged in the future.
@@ -1168,6 +1364,9 @@ struct ImDrawList
     ImVector<ImDrawCmd>     CmdBuffer;          // Commands. Typically 1 command = 1 gpu draw call.
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
+    ImVector<ImDrawIdxSpan> IdxSpans;           // Only used with UseIdxSpans: indices of merged channels which come before IdxBuffer. The full index buffer is IdxSpans[0], IdxSpans[1].. then IdxBuffer.
+    bool                    UseIdxSpans;        // Let ChannelsMerge() move channels indices into IdxSpans instead of copying them into IdxBuffer. Set from io.DrawListsUseIdxSpans for windows.
+    bool                    UseBuffersPool;     // Give VtxBuffer/IdxBuffer back to the context pool in Clear() and borrow from it in PrimReserve(). Set from io.DrawBuffersPoolDecayFrames for windows.
 
     // [Internal, used while building lists]
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
@@ -1180,8 +1379,12 @@ struct ImDrawList
     int                     _ChannelsCurrent;   // [Internal] current channel number (0)
     int                     _ChannelsCount;     // [Internal] number of active channels (1+)
     ImVector<ImDrawChannel> _Channels;          // [Internal] draw channels for columns API (not resized down so _ChannelsCount may be smaller than _Channels.Size)
+    ImVector<ImVector<ImDrawIdx> > _IdxSpansBuffers; // [Internal] storage for IdxSpans (not resized down, buffers are swapped with IdxBuffer and channels to be reused)
+    ImVec4                  _OpaqueRect;        // [Internal] area (x1,y1,x2,y2) covered by an opaque window background, set by ImGui::Begin() so ImGui::Render() can cull what is drawn behind it
+    int                     _VtxBufferSizeHint; // [Internal] VtxBuffer.Size when given back to the pool, PrimReserve() borrows that much room at once
+    int                     _IdxBufferSizeHint; // [Internal] IdxBuffer.Size when given back to the pool
 
-    ImDrawList()  { _OwnerName = NULL; Clear(); }
+    ImDrawList()  { _OwnerName = NULL; UseIdxSpans = UseBuffersPool = false; _VtxBufferSizeHint = _IdxBufferSizeHint = 0; Clear(); }
     ~ImDrawList() { ClearFreeMemory(); }
     IMGUI_API void  PushClipRect(ImVec2 clip_rect_min, ImVec2 clip_rect_max, bool intersect_with_current_clip_rect = false);  // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
     IMGUI_API void  PushClipRectFullScreen();
@@ -1221,9 +1424,12 @@ struct ImDrawList
     // Channels
     // - Use to simulate layers. By switching channels to can render out-of-order (e.g. submit foreground primitives before background primitives)
     // - Use to minimize draw calls (e.g. if going back-and-forth between multiple non-overlapping clipping rectangles, prefer to append into separate channels then merge at the end)
+    // - ChannelsMerge() copies the indices of every channel back into IdxBuffer, or with UseIdxSpans moves whole channels buffers into IdxSpans (cost doesn't depend on indices count)
     IMGUI_API void  ChannelsSplit(int channels_count);
     IMGUI_API void  ChannelsMerge();
     IMGUI_API void  ChannelsSetCurrent(int channel_index);
+    IMGUI_API void  MergeIdxSpans();                                            // Copy IdxSpans into IdxBuffer, for code that needs a single index buffer
+    IMGUI_API int   GetIdxCount() const;                                        // Total number of indices, IdxSpans included
 
     // Advanced
     IMGUI_API void  AddCallback(ImDrawCallback callback, void* callback_data);  // Your rendering function must check for 'UserCallback' in ImDrawCmd and call the function instead of rendering triangles.
@@ -1242,6 +1448,7 @@ struct ImDrawList
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)     { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); }
     IMGUI_API void  UpdateClipRect();
     IMGUI_API void  UpdateTextureID();
+    IMGUI_API void  ChannelsMoveToIdxSpans(ImVector<ImDrawIdx>& idx_buffer);
 };
 
 // All draw data to render an ImGui frame
@@ -1253,9 +1460,15 @@ struct ImDrawData
     int             TotalVtxCount;          // For convenience, sum of all cmd_lists vtx_buffer.Size
     int             TotalIdxCount;          // For convenience, sum of all cmd_lists idx_buffer.Size
 
+    // Only with io.DrawDataUseArenas, NULL otherwise
+    ImDrawVert*     VtxArena;               // Vertices of all cmd_lists, in order (TotalVtxCount). Vertices of CmdLists[n] start at VtxArena[VtxOffsets[n]].
+    ImDrawIdx*      IdxArena;               // Indices of all cmd_lists, IdxSpans included, in order (TotalIdxCount). Indices of CmdLists[n] start at IdxArena[IdxOffsets[n]] and are relative to its first vertex: use VtxOffsets[n] as base vertex.
+    int*            VtxOffsets;             // [CmdListsCount]
+    int*            IdxOffsets;             // [CmdListsCount]
+
     // Functions
-    ImDrawData() { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; }
-    IMGUI_API void DeIndexAllBuffers();               // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
+    ImDrawData() { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; VtxArena = NULL; IdxArena = NULL; VtxOffsets = IdxOffsets = NULL; }
+    IMGUI_API void DeIndexAllBuffers();               // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering! Discards the arenas.
     IMGUI_API void ScaleClipRects(const ImVec2& sc);  // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
 
@@ -1297,7 +1510,7 @@ struct ImFontAtlas
     IMGUI_API ImFont*           AddFontDefault(const ImFontConfig* font_cfg = NULL);
     IMGUI_API ImFont*           AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);
     IMGUI_API ImFont*           AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);                                        // Transfer ownership of 'ttf_data' to ImFontAtlas, will be deleted after Build()
-    IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);  // 'compressed_ttf_data' still owned by caller. Compress with binary_to_compressed_c.cpp
+    IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);  // 'compressed_ttf_data' still owned by caller. Compress with binary_to_compressed_c.cpp (-lz4 for faster decompression)
     IMGUI_API ImFont*           AddFontFromMemoryCompressedBase85TTF(const char* compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);              // 'compressed_ttf_data_base85' still owned by caller. Compress with binary_to_compressed_c.cpp with -base85 paramaeter
     IMGUI_API void              ClearTexData();             // Clear the CPU-side texture data. Saves RAM once the texture has been copied to graphics memory.
     IMGUI_API void              ClearInputData();           // Clear the input TTF data (inc sizes, glyph ranges)
@@ -1313,6 +1526,34 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     void                        SetTexID(void* id)  { TexID = id; }
 
+    // Signed distance field glyphs (set DistanceFieldGlyphs = true before building)
+    // Glyphs are baked as distance to their outline instead of coverage, so a single font size stays sharp when scaled up or down with SetWindowFontScale(),
+    // io.FontGlobalScale or ImFont::Scale. Bake at a medium size (e.g. 32 pixels), oversampling is ignored. This needs a shader for the font texture:
+    //     float d = texture(Texture, uv).a; float w = max(fwidth(d), 1e-5); alpha = clamp((d - 0.5) / w + 0.5, 0.0, 1.0);
+    // GetDistanceFieldAlpha() is the reference implementation, e.g. for a software renderer: 'texel' is the sampled value in [0,1], 'scale' the number of
+    // screen pixels per texel. The white pixel stays opaque with this shading, mouse cursors drawn from the atlas get hard edges.
+    IMGUI_API float             GetDistanceFieldAlpha(float texel, float scale) const;
+
+    // Build cache: skip TTF rasterization at startup by saving the built atlas, and loading it back on the next run after adding the same fonts.
+    // Loading fails if the fonts data, configuration or glyph ranges changed (see GetBuildCacheKey()): build as usual then and save a new cache.
+    // The cache data isn't referenced after loading, so it can be a memory-mapped file. Call ClearInputData() after loading to release the TTF data.
+    IMGUI_API ImU32             GetBuildCacheKey();         // Hash of the input TTF data, ImFontConfig settings and glyph ranges
+    IMGUI_API void*             SaveBuildCache(int* out_size);  // Build if needed and return cache data, to be freed with ImGui::MemFree()
+    IMGUI_API bool              LoadBuildCache(const void* data, int data_size);
+    IMGUI_API bool              SaveBuildCacheToFile(const char* filename);
+    IMGUI_API bool              LoadBuildCacheFromFile(const char* filename);
+
+    // Dynamic glyphs (set DynamicGlyphs = true before building)
+    // Build() only creates a fixed size texture (TexDesiredWidth or 1024, squared) with the space and fallback characters. Other glyphs in GlyphRanges are rasterized
+    // and packed the first time they are used. This allows large ranges (e.g. GetGlyphRangesChinese()) at a small memory and loading cost.
+    // Before rendering, call GetTexDataDirtyRect() and upload the modified part of the texture if it returns true.
+    // When the texture is full, the next NewFrame() repacks it, evicting least recently used glyphs (loaded again when needed) until about half of the texture is free.
+    // ImFont::Glyphs is reserved for every codepoint in GlyphRanges, so pointers returned by FindGlyph() stay valid while other glyphs are loaded, until a repack.
+    // The CPU-side pixels are kept (ClearTexData() has no effect) and so is the TTF data, calling ClearInputData() stops loading new glyphs.
+    // An atlas with DynamicGlyphs cannot be shared between contexts used from different threads.
+    IMGUI_API bool              GetTexDataDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h); // Return the area of the texture modified since the last call, and clear it
+    IMGUI_API void              UpdateDynamicGlyphs();      // Called by NewFrame()
+
     // Helpers to retrieve list of common Unicode ranges (2 value per range, values are inclusive, zero-terminated list)
     // NB: Make sure that your string are UTF-8 and NOT in your local code page. See FAQ for details.
     IMGUI_API const ImWchar*    GetGlyphRangesDefault();    // Basic Latin, Extended Latin
@@ -1331,10 +1572,22 @@ struct ImFontAtlas
     int                         TexHeight;          // Texture height calculated during Build().
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     ImVec2                      TexUvWhitePixel;    // Texture coordinates to a white pixel
+    int                         TexGeneration;      // Incremented when glyphs are moved within the texture, invalidating UV coordinates obtained before.
+    bool                        DynamicGlyphs;      // = false  // Rasterize glyphs on first use instead of during Build(). See "Dynamic glyphs" above.
+    bool                        DistanceFieldGlyphs;// = false  // Bake signed distance fields instead of coverage. See "Signed distance field glyphs" above.
+    int                         DistanceFieldPadding;// = 4     // Distance in pixels encoded around each glyph outline, in SizePixels units.
+
+    // Parallel build (optional): Build() spreads glyphs rasterization over jobs, which you can run with your own threads or job system.
+    // BuildRunJobsFn must call job_fn(job_data, n) for every n in [0, jobs_count) and return when all of them have completed. Jobs can run concurrently and
+    // in any order, the texture is the same as a serial build. They allocate memory with io.MemAllocFn/io.MemFreeFn directly, which must be thread-safe.
+    void                        (*BuildRunJobsFn)(void (*job_fn)(void* job_data, int job_index), void* job_data, int jobs_count, void* user_data);
+    void*                       BuildRunJobsUserData;
     ImVector<ImFont*>           Fonts;              // Hold all the fonts returned by AddFont*. Fonts[0] is the default font upon calling ImGui::NewFrame(), use ImGui::PushFont()/PopFont() to change the current font.
 
     // Private
     ImVector<ImFontConfig>      ConfigData;         // Internal data
+    int                         DynamicFrameCount;  // Incremented by UpdateDynamicGlyphs(), to track glyph usage
+    struct ImFontAtlasDynamicData* DynamicData;     // Font info and packing state kept alive when DynamicGlyphs is set
     IMGUI_API bool              Build();            // Build pixels data. This is automatically for you by the GetTexData*** functions.
     IMGUI_API void              RenderCustomTexData(int pass, void* rects);
 };
@@ -1355,10 +1608,11 @@ struct ImFont
     float                       FontSize;           // <user set>   // Height of characters, set during loading (don't change after loading)
     float                       Scale;              // = 1.f        // Base font scale, multiplied by the per-window font scale which you can adjust with SetFontScale()
     ImVec2                      DisplayOffset;      // = (0.f,1.f)  // Offset font rendering by xx pixels
-    ImVector<Glyph>             Glyphs;             //              // All glyphs.
-    ImVector<float>             IndexXAdvance;      //              // Sparse. Glyphs->XAdvance in a directly indexable way (more cache-friendly, for CalcTextSize functions which are often bottleneck in large UI).
-    ImVector<unsigned short>    IndexLookup;        //              // Sparse. Index glyphs by Unicode code-point.
-    const Glyph*                FallbackGlyph;      // == FindGlyph(FontFallbackChar)
+    // Glyphs, their index and GlyphsLastUsedFrame are mutable: with ImFontAtlas::DynamicGlyphs they are a cache filled by the const FindGlyph().
+    mutable ImVector<Glyph>     Glyphs;             //              // All glyphs.
+    mutable ImVector<float>     IndexXAdvance;      //              // Sparse. Glyphs->XAdvance in a directly indexable way (more cache-friendly, for CalcTextSize functions which are often bottleneck in large UI).
+    mutable ImVector<unsigned short> IndexLookup;   //              // Sparse. Index glyphs by Unicode code-point.
+    mutable const Glyph*        FallbackGlyph;      // == FindGlyph(FontFallbackChar)
     float                       FallbackXAdvance;   // == FallbackGlyph->XAdvance
     ImWchar                     FallbackChar;       // = '?'        // Replacement glyph if one isn't found. Only set via SetFallbackChar()
 
@@ -1367,6 +1621,7 @@ struct ImFont
     ImFontConfig*               ConfigData;         //              // Pointer within ContainerAtlas->ConfigData
     ImFontAtlas*                ContainerAtlas;     //              // What we has been loaded into
     float                       Ascent, Descent;    //              // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
+    mutable ImVector<int>       GlyphsLastUsedFrame;//              // Dynamic glyphs: value of ContainerAtlas->DynamicFrameCount when each glyph was last looked up
 
     // Methods
     IMGUI_API ImFont();
@@ -1375,7 +1630,7 @@ struct ImFont
     IMGUI_API void              BuildLookupTable();
     IMGUI_API const Glyph*      FindGlyph(ImWchar c) const;
     IMGUI_API void              SetFallbackChar(ImWchar c);
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexXAdvance.Size) ? IndexXAdvance[(int)c] : FallbackXAdvance; }
+    float                       GetCharAdvance(ImWchar c) const     { float advance = ((int)c < IndexXAdvance.Size) ? IndexXAdvance[(int)c] : FallbackXAdvance; return (advance >= 0.0f) ? advance : FindGlyph(c)->XAdvance; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
 
     // 'max_width' stops rendering after a certain width (could be turned into a 2d size). FLT_MAX to disable.
@@ -1386,8 +1641,9 @@ struct ImFont
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
 
     // Private
-    IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API void              GrowIndex(int new_size) const;
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
+    IMGUI_API const Glyph*      LoadDynamicGlyph(ImWchar c) const; // Called by FindGlyph() for codepoints in the font ranges which haven't been loaded yet
 };
 
 #if defined(__clang__)
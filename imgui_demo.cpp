@@ -311,6 +311,65 @@ void ImGui::ShowTestWindow(bool* p_open)
                     ImGui::Indent(ImGui::GetTreeNodeToLabelSpacing());
                 ImGui::TreePop();
             }
+
+            if (ImGui::TreeNode("Large tree, clipped"))
+            {
+                ShowHelpMarker("300000 nodes, only the visible rows are submitted using the ImGuiTreeClipper helper.\nClick to select, Up/Down to move the selection, Left/Right to close/open.");
+                // Implicit hierarchy: the children of node n are 10*(n+1)..10*(n+1)+9, the root (-1) has nodes 0..9
+                struct Funcs
+                {
+                    static void GetChildren(void*, int node, ImVector<int>* out_children)
+                    {
+                        const int nodes_count = 300000;
+                        for (int n = 10 * (node + 1); n < 10 * (node + 1) + 10 && n < nodes_count; n++)
+                            out_children->push_back(n);
+                    }
+                };
+                static ImGuiTreeClipper tree;
+                static int selected_node = -1, selected_row = -1, rows_count = -1;
+                ImGui::BeginChild("##tree", ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 12), true);
+                tree.Begin("tree", Funcs::GetChildren, NULL);
+                if (rows_count != tree.Rows.Size)
+                {
+                    // FindRow() is a linear search: only call it when nodes have been opened/closed, as the selected row may have moved
+                    selected_row = tree.FindRow(selected_node);
+                    rows_count = tree.Rows.Size;
+                }
+                if (ImGui::IsWindowFocused() && selected_row != -1)
+                {
+                    int new_row = selected_row;
+                    if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_UpArrow)) && new_row > 0) new_row--;
+                    if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_DownArrow)) && new_row + 1 < tree.Rows.Size) new_row++;
+                    if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_LeftArrow))) tree.SetNodeOpen(new_row, false);
+                    if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_RightArrow))) tree.SetNodeOpen(new_row, true);
+                    if (new_row != selected_row)
+                    {
+                        selected_node = tree.GetNode(new_row);
+                        selected_row = new_row;
+                        const float row_y = tree.StartPosY + new_row * tree.RowHeight;
+                        if (row_y < ImGui::GetScrollY())
+                            tree.ScrollToRow(new_row, 0.0f);
+                        else if (row_y + tree.RowHeight > ImGui::GetScrollY() + ImGui::GetWindowHeight())
+                            tree.ScrollToRow(new_row, 1.0f);
+                    }
+                }
+                while (tree.Step())
+                    for (int row = tree.DisplayStart; row < tree.DisplayEnd; row++)
+                    {
+                        const int node = tree.GetNode(row);
+                        char label[32];
+                        sprintf(label, "Node %d", node);
+                        tree.TreeNode(row, label, ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | (node == selected_node ? ImGuiTreeNodeFlags_Selected : 0));
+                        if (ImGui::IsItemClicked())
+                        {
+                            selected_node = node;
+                            selected_row = row;
+                        }
+                    }
+                ImGui::EndChild();
+                ImGui::Text("%d visible rows", tree.Rows.Size);
+                ImGui::TreePop();
+            }
             ImGui::TreePop();
         }
 
@@ -1480,6 +1539,40 @@ void ImGui::ShowTestWindow(bool* p_open)
             ImGui::Separator();
             ImGui::TreePop();
         }
+
+        if (ImGui::TreeNode("Table (1000000 x 200)"))
+        {
+            ImGui::TextWrapped("BeginTable() only submits the cells in view, so the size of the data set doesn't matter. The header row and first column stay in place while scrolling. Drag the header borders to resize columns.");
+            static int selected_row = -1;
+            const int columns_count = 200;
+            if (ImGui::BeginTable("##table", columns_count, 1000000, 1, ImVec2(0, 300)))
+            {
+                ImGui::TableSetupColumn("Row", 80.0f);
+                for (int column = 1; column < columns_count; column++)
+                {
+                    char label[32];
+                    sprintf(label, "Column %d", column);
+                    ImGui::TableSetupColumn(label, 90.0f);
+                }
+                int row, column;
+                while (ImGui::TableNextCell(&row, &column))
+                {
+                    if (column == 0)
+                    {
+                        char label[32];
+                        sprintf(label, "%d", row);
+                        if (ImGui::Selectable(label, selected_row == row))
+                            selected_row = row;
+                    }
+                    else
+                    {
+                        ImGui::Text("%08X", (unsigned int)(row * 2654435761u) ^ (unsigned int)column);
+                    }
+                }
+                ImGui::EndTable();
+            }
+            ImGui::TreePop();
+        }
     }
 
     if (ImGui::CollapsingHeader("Filtering"))
@@ -2375,26 +2468,34 @@ static void ShowExampleAppConsole(bool* p_open)
 //  my_log.Draw("title");
 struct ExampleAppLog
 {
-    ImGuiTextBuffer     Buf;
+    ImGuiTextChunkedBuffer Buf;             // Append-only, indexed by line
     ImGuiTextFilter     Filter;
-    ImVector<int>       LineOffsets;        // Index to lines offset
     bool                ScrollToBottom;
 
-    void    Clear()     { Buf.clear(); LineOffsets.clear(); }
+    void    Clear()     { Buf.clear(); Filter.Build(); }
+
+    static bool LineGetter(void* data, int idx, const char** out_text, const char** out_text_end)
+    {
+        *out_text = ((ExampleAppLog*)data)->Buf.get_line(idx, out_text_end);
+        return true;
+    }
 
     void    AddLog(const char* fmt, ...) IM_PRINTFARGS(2)
     {
-        int old_size = Buf.size();
         va_list args;
         va_start(args, fmt);
         Buf.appendv(fmt, args);
         va_end(args);
-        for (int new_size = Buf.size(); old_size < new_size; old_size++)
-            if (Buf[old_size] == '\n')
-                LineOffsets.push_back(old_size);
         ScrollToBottom = true;
     }
 
+    void    DrawLine(int line_idx)
+    {
+        const char* line_end;
+        const char* line = Buf.get_line(line_idx, &line_end);
+        ImGui::TextUnformatted(line, line_end);
+    }
+
     void    Draw(const char* title, bool* p_open = NULL)
     {
         ImGui::SetNextWindowSize(ImVec2(500,400), ImGuiSetCond_FirstUseEver);
@@ -2408,22 +2509,26 @@ struct ExampleAppLog
         ImGui::BeginChild("scrolling", ImVec2(0,0), false, ImGuiWindowFlags_HorizontalScrollbar);
         if (copy) ImGui::LogToClipboard();
 
-        if (Filter.IsActive())
+        // PassFilterLines() caches its results, so only the lines added since last frame are tested
+        const ImVector<int>* lines_passed = Filter.IsActive() ? &Filter.PassFilterLines(LineGetter, this, Buf.line_count()) : NULL;
+        const int lines_count = lines_passed ? lines_passed->Size : Buf.line_count();
+
+        ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0,0));
+        if (copy)
         {
-            const char* buf_begin = Buf.begin();
-            const char* line = buf_begin;
-            for (int line_no = 0; line != NULL; line_no++)
-            {
-                const char* line_end = (line_no < LineOffsets.Size) ? buf_begin + LineOffsets[line_no] : NULL;
-                if (Filter.PassFilter(line, line_end))
-                    ImGui::TextUnformatted(line, line_end);
-                line = line_end && line_end[1] ? line_end + 1 : NULL;
-            }
+            // Submit every line so they all get logged to the clipboard
+            for (int i = 0; i < lines_count; i++)
+                DrawLine(lines_passed ? (*lines_passed)[i] : i);
         }
         else
         {
-            ImGui::TextUnformatted(Buf.begin());
+            // Only submit the visible lines
+            ImGuiListClipper clipper(lines_count);
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                    DrawLine(lines_passed ? (*lines_passed)[i] : i);
         }
+        ImGui::PopStyleVar();
 
         if (ScrollToBottom)
             ImGui::SetScrollHere(1.0f);
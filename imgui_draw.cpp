@@ -18,6 +18,7 @@
 #include "imgui_internal.h"
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#include <stdlib.h>     // qsort
 #if !defined(alloca)
 #ifdef _WIN32
 #include <malloc.h>     // alloca
@@ -86,8 +87,15 @@ namespace IMGUI_STB_NAMESPACE
 #endif
 #include "stb_rect_pack.h"
 
-#define STBTT_malloc(x,u)  ((void)(u), ImGui::MemAlloc(x))
-#define STBTT_free(x,u)    ((void)(u), ImGui::MemFree(x))
+// Glyphs rasterized by ImFontAtlas::BuildRunJobsFn jobs set stbtt_fontinfo::userdata to an allocator, as ImGui::MemAlloc() isn't thread-safe (it needs the current context)
+struct ImFontBuildAllocator
+{
+    void*       (*AllocFn)(size_t sz);
+    void        (*FreeFn)(void* ptr);
+};
+
+#define STBTT_malloc(x,u)  ((u) ? ((ImFontBuildAllocator*)(u))->AllocFn(x) : ImGui::MemAlloc(x))
+#define STBTT_free(x,u)    ((u) ? ((ImFontBuildAllocator*)(u))->FreeFn(x) : ImGui::MemFree(x))
 #define STBTT_assert(x)    IM_ASSERT(x)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 #define STBTT_STATIC
@@ -120,11 +128,167 @@ using namespace IMGUI_STB_NAMESPACE;
 
 static const ImVec4 GNullClipRect(-8192.0f, -8192.0f, +8192.0f, +8192.0f); // Large values that are easy to encode in a few bits+shift
 
+// Size classes of the pool: 4 per power of two of units of sizeof(ImDrawVert)*sizeof(ImDrawIdx) bytes, e.g. 8, 10, 12, 14, 16 units.
+// A block allocated by the pool is a multiple of both element sizes, so the buffer borrowing it gives back the whole block, filed under the same class.
+static const int DrawBuffersPoolUnit = (int)(sizeof(ImDrawVert) * sizeof(ImDrawIdx));
+
+static int DrawBuffersPoolSizeClass(int bytes)
+{
+    const int units = bytes / DrawBuffersPoolUnit;
+    int e = 0;
+    while (units >> (e + 1))
+        e++;
+    return (e < 2) ? units : e * 4 + ((units >> (e - 2)) & 3);
+}
+
+static int DrawBuffersPoolRoundUp(int bytes)
+{
+    const int units = (bytes + DrawBuffersPoolUnit - 1) / DrawBuffersPoolUnit;
+    int e = 0;
+    while (units >> (e + 1))
+        e++;
+    const int step = (e < 2) ? 1 : (1 << (e - 2));
+    return ((units + step - 1) & ~(step - 1)) * DrawBuffersPoolUnit;
+}
+
+// Free block of at least min_bytes. Blocks of the size class of min_bytes rounded up are smaller than the next class, so we take the last released one.
+void* ImGuiDrawBuffersPool::Acquire(int min_bytes, int* out_bytes)
+{
+    const int bytes = DrawBuffersPoolRoundUp(min_bytes);
+    ImVector<ImGuiDrawBuffersPoolBlock>& bucket = FreeBlocks[DrawBuffersPoolSizeClass(bytes)];
+    if (bucket.empty())
+    {
+        *out_bytes = bytes;
+        return ImGui::MemAlloc((size_t)bytes);
+    }
+    const ImGuiDrawBuffersPoolBlock& block = bucket.back();
+    void* data = block.Data;
+    *out_bytes = block.Bytes;
+    FreeBytes -= block.Bytes;
+    FreeBlocksCount--;
+    bucket.pop_back();
+    return data;
+}
+
+void ImGuiDrawBuffersPool::Release(void* data, int bytes)
+{
+    ImGuiDrawBuffersPoolBlock block;
+    block.Data = data;
+    block.Bytes = bytes;
+    block.FrameReleased = FrameCount;
+    FreeBlocks[DrawBuffersPoolSizeClass(bytes)].push_back(block);
+    FreeBlocksCount++;
+    FreeBytes += bytes;
+}
+
+void ImGuiDrawBuffersPool::GarbageCollect(int frame_count, int decay_frames)
+{
+    FrameCount = frame_count;
+    if (decay_frames < 0)
+    {
+        Clear();
+        return;
+    }
+    if (UsedBytes >= PeakUsedBytes || frame_count - PeakUsedFrame > decay_frames)
+    {
+        PeakUsedBytes = UsedBytes;
+        PeakUsedFrame = frame_count;
+    }
+    if (FreeBlocksCount == 0)
+        return;
+
+    // Blocks of each bucket are in release order so we only ever release a prefix of them
+    const int buckets_count = IM_ARRAYSIZE(FreeBlocks);
+    int released[IM_ARRAYSIZE(FreeBlocks)];
+    for (int b = 0; b < buckets_count; b++)
+    {
+        ImVector<ImGuiDrawBuffersPoolBlock>& bucket = FreeBlocks[b];
+        int n = 0;
+        while (n < bucket.Size && frame_count - bucket[n].FrameReleased > decay_frames)
+        {
+            ImGui::MemFree(bucket[n].Data);
+            FreeBytes -= bucket[n].Bytes;
+            n++;
+        }
+        released[b] = n;
+    }
+    while (FreeBytes > PeakUsedBytes)
+    {
+        int oldest = -1;
+        for (int b = 0; b < buckets_count; b++)
+            if (released[b] < FreeBlocks[b].Size && (oldest == -1 || FreeBlocks[b][released[b]].FrameReleased < FreeBlocks[oldest][released[oldest]].FrameReleased))
+                oldest = b;
+        if (oldest == -1)
+            break;
+        ImGui::MemFree(FreeBlocks[oldest][released[oldest]].Data);
+        FreeBytes -= FreeBlocks[oldest][released[oldest]].Bytes;
+        released[oldest]++;
+    }
+    for (int b = 0; b < buckets_count; b++)
+    {
+        ImVector<ImGuiDrawBuffersPoolBlock>& bucket = FreeBlocks[b];
+        const int n = released[b];
+        if (n == 0)
+            continue;
+        memmove(bucket.Data, bucket.Data + n, (size_t)(bucket.Size - n) * sizeof(ImGuiDrawBuffersPoolBlock));
+        bucket.resize(bucket.Size - n);
+        FreeBlocksCount -= n;
+    }
+}
+
+void ImGuiDrawBuffersPool::Clear()
+{
+    for (int b = 0; b < IM_ARRAYSIZE(FreeBlocks); b++)
+    {
+        for (int n = 0; n < FreeBlocks[b].Size; n++)
+            ImGui::MemFree(FreeBlocks[b][n].Data);
+        FreeBlocks[b].clear();
+    }
+    FreeBlocksCount = FreeBytes = UsedBytes = PeakUsedBytes = 0;
+}
+
+// Move the content of 'buf' into a block of the context pool with room for at least 'new_size' elements, giving the previous allocation back to the pool
+template<typename T>
+static void GrowBufferFromPool(ImVector<T>& buf, int new_size, int size_hint)
+{
+    ImGuiDrawBuffersPool& pool = GImGui->DrawBuffersPool;
+    int bytes = 0;
+    T* new_data = (T*)pool.Acquire(ImMax(buf._grow_capacity(new_size), size_hint) * (int)sizeof(T), &bytes);
+    if (buf.Size > 0)
+        memcpy(new_data, buf.Data, (size_t)buf.Size * sizeof(T));
+    if (buf.Data)
+        pool.Release(buf.Data, buf.Capacity * (int)sizeof(T));
+    buf.Data = new_data;
+    buf.Capacity = bytes / (int)sizeof(T);
+}
+
+template<typename T>
+static void ReleaseBufferToPool(ImVector<T>& buf)
+{
+    if (buf.Data)
+        GImGui->DrawBuffersPool.Release(buf.Data, buf.Capacity * (int)sizeof(T));
+    buf.Data = NULL;
+    buf.Size = buf.Capacity = 0;
+}
+
 void ImDrawList::Clear()
 {
     CmdBuffer.resize(0);
-    IdxBuffer.resize(0);
-    VtxBuffer.resize(0);
+    if (UseBuffersPool)
+    {
+        // Keep the hints of the last frame which drew something, a second Clear() would see the empty buffers we just gave back
+        if (VtxBuffer.Data && VtxBuffer.Size > 0)
+            _VtxBufferSizeHint = VtxBuffer.Size;
+        if (IdxBuffer.Data && IdxBuffer.Size > 0)
+            _IdxBufferSizeHint = IdxBuffer.Size;
+        ReleaseBufferToPool(VtxBuffer);
+        ReleaseBufferToPool(IdxBuffer);
+    }
+    else
+    {
+        IdxBuffer.resize(0);
+        VtxBuffer.resize(0);
+    }
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
@@ -133,6 +297,8 @@ void ImDrawList::Clear()
     _Path.resize(0);
     _ChannelsCurrent = 0;
     _ChannelsCount = 1;
+    IdxSpans.resize(0);
+    _OpaqueRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
     // NB: Do not clear channels so our allocations are re-used after the first frame.
 }
 
@@ -149,6 +315,7 @@ void ImDrawList::ClearFreeMemory()
     _Path.clear();
     _ChannelsCurrent = 0;
     _ChannelsCount = 1;
+    _VtxBufferSizeHint = _IdxBufferSizeHint = 0;
     for (int i = 0; i < _Channels.Size; i++)
     {
         if (i == 0) memset(&_Channels[0], 0, sizeof(_Channels[0]));  // channel 0 is a copy of CmdBuffer/IdxBuffer, don't destruct again
@@ -156,6 +323,11 @@ void ImDrawList::ClearFreeMemory()
         _Channels[i].IdxBuffer.clear();
     }
     _Channels.clear();
+    for (int i = 0; i < _IdxSpansBuffers.Size; i++)
+        _IdxSpansBuffers[i].clear();
+    _IdxSpansBuffers.clear();
+    IdxSpans.clear();
+    _OpaqueRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
 }
 
 // Use macros because C++ is a terrible language, we want guaranteed inline, no code in header, and no overhead in Debug mode
@@ -327,20 +499,79 @@ void ImDrawList::ChannelsMerge()
         new_idx_buffer_count += ch.IdxBuffer.Size;
     }
     CmdBuffer.resize(CmdBuffer.Size + new_cmd_buffer_count);
-    IdxBuffer.resize(IdxBuffer.Size + new_idx_buffer_count);
-
     ImDrawCmd* cmd_write = CmdBuffer.Data + CmdBuffer.Size - new_cmd_buffer_count;
-    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size - new_idx_buffer_count;
-    for (int i = 1; i < _ChannelsCount; i++)
+    if (UseIdxSpans)
     {
-        ImDrawChannel& ch = _Channels[i];
-        if (int sz = ch.CmdBuffer.Size) { memcpy(cmd_write, ch.CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
-        if (int sz = ch.IdxBuffer.Size) { memcpy(_IdxWritePtr, ch.IdxBuffer.Data, sz * sizeof(ImDrawIdx)); _IdxWritePtr += sz; }
+        // Move the main buffer then each channel buffer into IdxSpans, subsequent primitives are appended to an empty IdxBuffer
+        if (IdxBuffer.Size) ChannelsMoveToIdxSpans(IdxBuffer);
+        for (int i = 1; i < _ChannelsCount; i++)
+        {
+            ImDrawChannel& ch = _Channels[i];
+            if (int sz = ch.CmdBuffer.Size) { memcpy(cmd_write, ch.CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
+            if (ch.IdxBuffer.Size) ChannelsMoveToIdxSpans(ch.IdxBuffer);
+        }
+        _IdxWritePtr = IdxBuffer.Data;
+    }
+    else
+    {
+        IdxBuffer.resize(IdxBuffer.Size + new_idx_buffer_count);
+        _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size - new_idx_buffer_count;
+        for (int i = 1; i < _ChannelsCount; i++)
+        {
+            ImDrawChannel& ch = _Channels[i];
+            if (int sz = ch.CmdBuffer.Size) { memcpy(cmd_write, ch.CmdBuffer.Data, sz * sizeof(ImDrawCmd)); cmd_write += sz; }
+            if (int sz = ch.IdxBuffer.Size) { memcpy(_IdxWritePtr, ch.IdxBuffer.Data, sz * sizeof(ImDrawIdx)); _IdxWritePtr += sz; }
+        }
     }
     AddDrawCmd();
     _ChannelsCount = 1;
 }
 
+// Append the content of 'idx_buffer' to IdxSpans by swapping it with a storage buffer, which leaves 'idx_buffer' empty with the storage previous allocation.
+// Data pointers of IdxSpans stay valid until Clear() as the storage buffers aren't modified until then.
+void ImDrawList::ChannelsMoveToIdxSpans(ImVector<ImDrawIdx>& idx_buffer)
+{
+    const int n = IdxSpans.Size;
+    if (n == _IdxSpansBuffers.Size)
+    {
+        _IdxSpansBuffers.resize(n + 1);
+        IM_PLACEMENT_NEW(&_IdxSpansBuffers[n]) ImVector<ImDrawIdx>();
+    }
+    ImVector<ImDrawIdx>& storage = _IdxSpansBuffers[n];
+    storage.swap(idx_buffer);
+    idx_buffer.resize(0);
+    ImDrawIdxSpan span;
+    span.IdxData = storage.Data;
+    span.IdxCount = storage.Size;
+    IdxSpans.push_back(span);
+}
+
+void ImDrawList::MergeIdxSpans()
+{
+    if (IdxSpans.Size == 0)
+        return;
+    const int idx_count = GetIdxCount();
+    const int tail_count = IdxBuffer.Size;
+    IdxBuffer.resize(idx_count);
+    memmove(IdxBuffer.Data + idx_count - tail_count, IdxBuffer.Data, tail_count * sizeof(ImDrawIdx));
+    ImDrawIdx* idx_write = IdxBuffer.Data;
+    for (int i = 0; i < IdxSpans.Size; i++)
+    {
+        memcpy(idx_write, IdxSpans[i].IdxData, IdxSpans[i].IdxCount * sizeof(ImDrawIdx));
+        idx_write += IdxSpans[i].IdxCount;
+    }
+    IdxSpans.resize(0);
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+}
+
+int ImDrawList::GetIdxCount() const
+{
+    int idx_count = IdxBuffer.Size;
+    for (int i = 0; i < IdxSpans.Size; i++)
+        idx_count += IdxSpans[i].IdxCount;
+    return idx_count;
+}
+
 void ImDrawList::ChannelsSetCurrent(int idx)
 {
     IM_ASSERT(idx < _ChannelsCount);
@@ -360,10 +591,14 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     draw_cmd.ElemCount += idx_count;
 
     int vtx_buffer_size = VtxBuffer.Size;
+    if (UseBuffersPool && vtx_buffer_size + vtx_count > VtxBuffer.Capacity)
+        GrowBufferFromPool(VtxBuffer, vtx_buffer_size + vtx_count, _VtxBufferSizeHint);
     VtxBuffer.resize(vtx_buffer_size + vtx_count);
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_size;
 
     int idx_buffer_size = IdxBuffer.Size;
+    if (UseBuffersPool && idx_buffer_size + idx_count > IdxBuffer.Capacity)
+        GrowBufferFromPool(IdxBuffer, idx_buffer_size + idx_count, _IdxBufferSizeHint);
     IdxBuffer.resize(idx_buffer_size + idx_count);
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_size;
 }
@@ -581,10 +816,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
             const float dx = diff.x * (thickness * 0.5f);
             const float dy = diff.y * (thickness * 0.5f);
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[0].pos = ImVec2(p1.x + dy, p1.y - dx); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = ImVec2(p2.x + dy, p2.y - dx); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = ImVec2(p2.x - dy, p2.y + dx); _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = ImVec2(p1.x - dy, p1.y + dx); _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
@@ -678,22 +913,24 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     }
 }
 
-void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int amax)
+// Unit circle vertices for PathArcToFast(). Built during static initialization rather than lazily, so concurrent contexts on different threads don't race on it.
+static ImVec2 GCircleVtx12[12];
+static struct ImCircleVtx12Builder
 {
-    static ImVec2 circle_vtx[12];
-    static bool circle_vtx_builds = false;
-    const int circle_vtx_count = IM_ARRAYSIZE(circle_vtx);
-    if (!circle_vtx_builds)
+    ImCircleVtx12Builder()
     {
+        const int circle_vtx_count = IM_ARRAYSIZE(GCircleVtx12);
         for (int i = 0; i < circle_vtx_count; i++)
         {
             const float a = ((float)i / (float)circle_vtx_count) * 2*IM_PI;
-            circle_vtx[i].x = cosf(a);
-            circle_vtx[i].y = sinf(a);
+            GCircleVtx12[i].x = cosf(a);
+            GCircleVtx12[i].y = sinf(a);
         }
-        circle_vtx_builds = true;
     }
+} GCircleVtx12Builder;
 
+void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int amax)
+{
     if (amin > amax) return;
     if (radius == 0.0f)
     {
@@ -704,7 +941,7 @@ void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int amin, int
         _Path.reserve(_Path.Size + (amax - amin + 1));
         for (int a = amin; a <= amax; a++)
         {
-            const ImVec2& c = circle_vtx[a % circle_vtx_count];
+            const ImVec2& c = GCircleVtx12[a % IM_ARRAYSIZE(GCircleVtx12)];
             _Path.push_back(ImVec2(centre.x + c.x * radius, centre.y + c.y * radius));
         }
     }
@@ -963,16 +1200,37 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& a, const Im
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
-    // FIXME-OPT: This is wasting draw calls.
-    const bool push_texture_id = _TextureIdStack.empty() || user_texture_id != _TextureIdStack.back();
-    if (push_texture_id)
-        PushTextureID(user_texture_id);
+    if (!_TextureIdStack.empty() && user_texture_id == _TextureIdStack.back())
+    {
+        PrimReserve(6, 4);
+        PrimRectUV(a, b, uv0, uv1, col);
+        return;
+    }
+
+    // Append to the previous command if it uses this texture and clipping rectangle (e.g. consecutive images), reuse the current command if it is empty, else start a new one.
+    // Then start a new command with the current texture for the primitives that follow.
+    if (CmdBuffer.Size == 0)
+        AddDrawCmd();
+    ImDrawCmd* curr_cmd = &CmdBuffer.back();
+    ImDrawCmd* prev_cmd = CmdBuffer.Size > 1 ? curr_cmd - 1 : NULL;
+    const bool curr_cmd_empty = (curr_cmd->ElemCount == 0 && curr_cmd->UserCallback == NULL);
+    if (curr_cmd_empty && prev_cmd && prev_cmd->TextureId == user_texture_id && prev_cmd->UserCallback == NULL && memcmp(&prev_cmd->ClipRect, &curr_cmd->ClipRect, sizeof(ImVec4)) == 0)
+    {
+        CmdBuffer.pop_back();
+    }
+    else if (curr_cmd_empty)
+    {
+        curr_cmd->TextureId = user_texture_id;
+    }
+    else
+    {
+        AddDrawCmd();
+        CmdBuffer.back().TextureId = user_texture_id;
+    }
 
     PrimReserve(6, 4);
     PrimRectUV(a, b, uv0, uv1, col);
-
-    if (push_texture_id)
-        PopTextureID();
+    AddDrawCmd();
 }
 
 //-----------------------------------------------------------------------------
@@ -984,9 +1242,13 @@ void ImDrawData::DeIndexAllBuffers()
 {
     ImVector<ImDrawVert> new_vtx_buffer;
     TotalVtxCount = TotalIdxCount = 0;
+    VtxArena = NULL;
+    IdxArena = NULL;
+    VtxOffsets = IdxOffsets = NULL;
     for (int i = 0; i < CmdListsCount; i++)
     {
         ImDrawList* cmd_list = CmdLists[i];
+        cmd_list->MergeIdxSpans();
         if (cmd_list->IdxBuffer.empty())
             continue;
         new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
@@ -1034,6 +1296,172 @@ ImFontConfig::ImFontConfig()
     memset(Name, 0, sizeof(Name));
 }
 
+static bool ImFontAtlasDynamicBuild(ImFontAtlas* atlas);
+static void ImFontAtlasDynamicDestroy(ImFontAtlas* atlas);
+
+// Signed distance field glyphs (ImFontAtlas::DistanceFieldGlyphs)
+// Texels store 0.5 + distance / (2 * DistanceFieldPadding), where the distance to the outline is in pixels at SizePixels, positive inside the glyph.
+// The two functions below mirror stbtt_PackFontRangesGatherRects() and stbtt_PackFontRangesRenderIntoRects(), filling stbtt_packedchar the same way (without oversampling).
+
+#define IM_FONT_SDF_CURVE_SEGMENTS  8       // Number of line segments used to approximate each quadratic curve of the outline
+
+// Compute the distance field of a glyph outline at the centers of the w*h pixels starting at (origin_x, origin_y) in stbtt bitmap space (y down)
+static void ImFontAtlasRenderGlyphSdf(const stbtt_fontinfo* info, int glyph, float scale, int origin_x, int origin_y, int w, int h, int sdf_padding, unsigned char* out, int out_stride)
+{
+    stbtt_vertex* vertices = NULL;
+    const int vertices_count = stbtt_GetGlyphShape(info, glyph, &vertices);
+
+    // Flatten the outline
+    int segments_max = 1;
+    for (int n = 0; n < vertices_count; n++)
+        segments_max += (vertices[n].type == STBTT_vcurve) ? IM_FONT_SDF_CURVE_SEGMENTS : 1;
+    ImVec4* segments = (ImVec4*)STBTT_malloc(sizeof(ImVec4) * segments_max, info->userdata);
+    int segments_count = 0;
+    ImVec2 p0(0.0f, 0.0f);
+    for (int n = 0; n < vertices_count; n++)
+    {
+        const stbtt_vertex& v = vertices[n];
+        const ImVec2 p1(v.x * scale, -v.y * scale);
+        if (v.type == STBTT_vline)
+        {
+            segments[segments_count++] = ImVec4(p0.x, p0.y, p1.x, p1.y);
+        }
+        else if (v.type == STBTT_vcurve)
+        {
+            const ImVec2 c(v.cx * scale, -v.cy * scale);
+            ImVec2 prev = p0;
+            for (int i = 1; i <= IM_FONT_SDF_CURVE_SEGMENTS; i++)
+            {
+                const float t = (float)i / IM_FONT_SDF_CURVE_SEGMENTS, u = 1.0f - t;
+                const ImVec2 p(u*u*p0.x + 2.0f*u*t*c.x + t*t*p1.x, u*u*p0.y + 2.0f*u*t*c.y + t*t*p1.y);
+                segments[segments_count++] = ImVec4(prev.x, prev.y, p.x, p.y);
+                prev = p;
+            }
+        }
+        p0 = p1;
+    }
+    stbtt_FreeShape(info, vertices);
+
+    // For each pixel: distance to the closest segment, signed with the non-zero winding rule.
+    // Distances are clamped to sdf_padding, so segments whose bounding box is further away are only used for winding.
+    const float dist_max = (float)sdf_padding;
+    const float dist_scale = 0.5f / sdf_padding;
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+        {
+            const float px = origin_x + x + 0.5f, py = origin_y + y + 0.5f;
+            float min_dist_sqr = dist_max * dist_max;
+            int winding = 0;
+            for (int n = 0; n < segments_count; n++)
+            {
+                const ImVec4& seg = segments[n];
+                const float dx = seg.z - seg.x, dy = seg.w - seg.y;
+                if ((seg.y <= py) != (seg.w <= py) && seg.x + (py - seg.y) * dx / dy > px)
+                    winding += (seg.w > seg.y) ? 1 : -1;
+                if (px < ImMin(seg.x, seg.z) - dist_max || px > ImMax(seg.x, seg.z) + dist_max || py < ImMin(seg.y, seg.w) - dist_max || py > ImMax(seg.y, seg.w) + dist_max)
+                    continue;
+                const float len_sqr = dx*dx + dy*dy;
+                const float t = (len_sqr > 0.0f) ? ImSaturate(((px - seg.x) * dx + (py - seg.y) * dy) / len_sqr) : 0.0f;
+                const float ex = seg.x + dx * t - px, ey = seg.y + dy * t - py;
+                min_dist_sqr = ImMin(min_dist_sqr, ex*ex + ey*ey);
+            }
+            const float dist = (winding != 0) ? sqrtf(min_dist_sqr) : -sqrtf(min_dist_sqr);
+            out[y * out_stride + x] = (unsigned char)(ImSaturate(0.5f + dist * dist_scale) * 255.0f + 0.5f);
+        }
+    STBTT_free(segments, info->userdata);
+}
+
+static int ImFontAtlasSdfGatherRects(stbtt_pack_context* spc, const stbtt_fontinfo* info, stbtt_pack_range* ranges, int num_ranges, stbrp_rect* rects, int sdf_padding)
+{
+    int k = 0;
+    for (int i = 0; i < num_ranges; i++)
+    {
+        const float scale = stbtt_ScaleForPixelHeight(info, ranges[i].font_size);
+        ranges[i].h_oversample = ranges[i].v_oversample = 1;
+        for (int j = 0; j < ranges[i].num_chars; j++, k++)
+        {
+            int x0, y0, x1, y1;
+            stbtt_GetGlyphBitmapBox(info, stbtt_FindGlyphIndex(info, ranges[i].first_unicode_codepoint_in_range + j), scale, scale, &x0, &y0, &x1, &y1);
+            const int margin = (x1 > x0 && y1 > y0) ? sdf_padding : 0;
+            rects[k].w = (stbrp_coord)(x1 - x0 + margin * 2 + spc->padding);
+            rects[k].h = (stbrp_coord)(y1 - y0 + margin * 2 + spc->padding);
+        }
+    }
+    return k;
+}
+
+static void ImFontAtlasSdfRenderIntoRects(stbtt_pack_context* spc, const stbtt_fontinfo* info, stbtt_pack_range* ranges, int num_ranges, stbrp_rect* rects, int sdf_padding)
+{
+    int k = 0;
+    for (int i = 0; i < num_ranges; i++)
+    {
+        const float scale = stbtt_ScaleForPixelHeight(info, ranges[i].font_size);
+        for (int j = 0; j < ranges[i].num_chars; j++, k++)
+        {
+            stbrp_rect* r = &rects[k];
+            if (!r->was_packed)
+                continue;
+            int advance, lsb, x0, y0, x1, y1;
+            const int glyph = stbtt_FindGlyphIndex(info, ranges[i].first_unicode_codepoint_in_range + j);
+            stbtt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
+            stbtt_GetGlyphBitmapBox(info, glyph, scale, scale, &x0, &y0, &x1, &y1);
+            const int margin = (x1 > x0 && y1 > y0) ? sdf_padding : 0;
+
+            // Pad on left and top
+            r->x += (stbrp_coord)spc->padding;
+            r->y += (stbrp_coord)spc->padding;
+            r->w -= (stbrp_coord)spc->padding;
+            r->h -= (stbrp_coord)spc->padding;
+            if (margin > 0)
+                ImFontAtlasRenderGlyphSdf(info, glyph, scale, x0 - margin, y0 - margin, r->w, r->h, sdf_padding, spc->pixels + r->x + r->y * spc->stride_in_bytes, spc->stride_in_bytes);
+
+            stbtt_packedchar* bc = &ranges[i].chardata_for_range[j];
+            bc->x0 = (unsigned short)r->x;
+            bc->y0 = (unsigned short)r->y;
+            bc->x1 = (unsigned short)(r->x + r->w);
+            bc->y1 = (unsigned short)(r->y + r->h);
+            bc->xadvance = scale * advance;
+            bc->xoff = (float)(x0 - margin);
+            bc->yoff = (float)(y0 - margin);
+            bc->xoff2 = (float)(x0 - margin + r->w);
+            bc->yoff2 = (float)(y0 - margin + r->h);
+        }
+    }
+}
+
+#define IM_FONT_BUILD_JOB_GLYPHS    128     // Maximum number of glyphs rasterized by one job in Build()
+
+struct ImFontBuildRenderJob
+{
+    const stbtt_fontinfo*   FontInfo;
+    stbtt_pack_range        Range;          // Part of a range of the source font, up to IM_FONT_BUILD_JOB_GLYPHS
+    stbrp_rect*             Rects;
+};
+
+struct ImFontBuildRenderJobs
+{
+    ImVector<ImFontBuildRenderJob> Jobs;
+    stbtt_pack_context      PackContext;
+    ImFontBuildAllocator    Allocator;      // Only used when jobs run through BuildRunJobsFn
+    int                     SdfPadding;     // > 0 to render signed distance fields
+
+    ImFontBuildRenderJobs() { memset(&PackContext, 0, sizeof(PackContext)); Allocator.AllocFn = NULL; Allocator.FreeFn = NULL; SdfPadding = 0; }
+};
+
+static void ImFontAtlasBuildRenderJob(void* job_data, int job_index)
+{
+    ImFontBuildRenderJobs* jobs = (ImFontBuildRenderJobs*)job_data;
+    const ImFontBuildRenderJob& job = jobs->Jobs[job_index];
+    stbtt_pack_context spc = jobs->PackContext;     // stbtt temporarily modifies the oversampling settings
+    stbtt_fontinfo font_info = *job.FontInfo;
+    font_info.userdata = jobs->Allocator.AllocFn ? &jobs->Allocator : NULL;
+    stbtt_pack_range range = job.Range;
+    if (jobs->SdfPadding > 0)
+        ImFontAtlasSdfRenderIntoRects(&spc, &font_info, &range, 1, job.Rects, jobs->SdfPadding);
+    else
+        stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &range, 1, job.Rects);
+}
+
 ImFontAtlas::ImFontAtlas()
 {
     TexID = NULL;
@@ -1041,6 +1469,14 @@ ImFontAtlas::ImFontAtlas()
     TexPixelsRGBA32 = NULL;
     TexWidth = TexHeight = TexDesiredWidth = 0;
     TexUvWhitePixel = ImVec2(0, 0);
+    TexGeneration = 0;
+    DynamicGlyphs = false;
+    DistanceFieldGlyphs = false;
+    DistanceFieldPadding = 4;
+    BuildRunJobsFn = NULL;
+    BuildRunJobsUserData = NULL;
+    DynamicFrameCount = 0;
+    DynamicData = NULL;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -1050,6 +1486,7 @@ ImFontAtlas::~ImFontAtlas()
 
 void    ImFontAtlas::ClearInputData()
 {
+    ImFontAtlasDynamicDestroy(this);    // Dynamic glyphs are rasterized from the input data
     for (int i = 0; i < ConfigData.Size; i++)
         if (ConfigData[i].FontData && ConfigData[i].FontDataOwnedByAtlas)
         {
@@ -1069,6 +1506,8 @@ void    ImFontAtlas::ClearInputData()
 
 void    ImFontAtlas::ClearTexData()
 {
+    if (DynamicData)    // Dynamic glyphs are rasterized into the CPU-side texture data, keep it
+        return;
     if (TexPixelsAlpha8)
         ImGui::MemFree(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -1079,6 +1518,7 @@ void    ImFontAtlas::ClearTexData()
 
 void    ImFontAtlas::ClearFonts()
 {
+    ImFontAtlasDynamicDestroy(this);
     for (int i = 0; i < Fonts.Size; i++)
     {
         Fonts[i]->~ImFont();
@@ -1131,6 +1571,12 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+float   ImFontAtlas::GetDistanceFieldAlpha(float texel, float scale) const
+{
+    const float distance = (texel - 0.5f) * 2.0f * DistanceFieldPadding;   // In texels, positive inside the glyph
+    return ImSaturate(0.5f + distance * scale);
+}
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
@@ -1163,6 +1609,9 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 // Default font TTF is compressed with stb_compress then base85 encoded (see extra_fonts/binary_to_compressed_c.cpp for encoder)
 static unsigned int stb_decompress_length(unsigned char *input);
 static unsigned int stb_decompress(unsigned char *output, unsigned char *i, unsigned int length);
+static bool         ImLz4IsCompressed(const unsigned char* input, unsigned int length);
+static unsigned int ImLz4DecompressLength(const unsigned char* input);
+static unsigned int ImLz4Decompress(unsigned char* output, const unsigned char* input, unsigned int length);
 static const char*  GetDefaultCompressedFontDataTTFBase85();
 static unsigned int Decode85Byte(char c)                                    { return c >= '\\' ? c-36 : c-35; }
 static void         Decode85(const unsigned char* src, unsigned char* dst)
@@ -1227,9 +1676,26 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float si
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
-    const unsigned int buf_decompressed_size = stb_decompress_length((unsigned char*)compressed_ttf_data);
-    unsigned char* buf_decompressed_data = (unsigned char *)ImGui::MemAlloc(buf_decompressed_size);
-    stb_decompress(buf_decompressed_data, (unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
+    // Both stb_compress() and LZ4-style (binary_to_compressed_c.cpp -lz4) data are accepted, the latter decompresses several times faster
+    unsigned char* buf_decompressed_data;
+    unsigned int buf_decompressed_size;
+    if (ImLz4IsCompressed((const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size))
+    {
+        buf_decompressed_size = ImLz4DecompressLength((const unsigned char*)compressed_ttf_data);
+        buf_decompressed_data = (unsigned char *)ImGui::MemAlloc(buf_decompressed_size);
+        if (ImLz4Decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size) != buf_decompressed_size)
+        {
+            IM_ASSERT(0); // Corrupted data.
+            ImGui::MemFree(buf_decompressed_data);
+            return NULL;
+        }
+    }
+    else
+    {
+        buf_decompressed_size = stb_decompress_length((unsigned char*)compressed_ttf_data);
+        buf_decompressed_data = (unsigned char *)ImGui::MemAlloc(buf_decompressed_size);
+        stb_decompress(buf_decompressed_data, (unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
+    }
 
     ImFontConfig font_cfg = font_cfg_template ? *font_cfg_template : ImFontConfig();
     IM_ASSERT(font_cfg.FontData == NULL);
@@ -1254,7 +1720,11 @@ bool    ImFontAtlas::Build()
     TexID = NULL;
     TexWidth = TexHeight = 0;
     TexUvWhitePixel = ImVec2(0, 0);
+    TexGeneration++;
+    ImFontAtlasDynamicDestroy(this);
     ClearTexData();
+    if (DynamicGlyphs)
+        return ImFontAtlasDynamicBuild(this);
 
     struct ImFontTempBuildData
     {
@@ -1278,6 +1748,7 @@ bool    ImFontAtlas::Build()
         IM_ASSERT(font_offset >= 0);
         if (!stbtt_InitFont(&tmp.FontInfo, (unsigned char*)cfg.FontData, font_offset))
             return false;
+        tmp.FontInfo.userdata = NULL;
 
         // Count glyphs
         if (!cfg.GlyphRanges)
@@ -1347,7 +1818,7 @@ bool    ImFontAtlas::Build()
         tmp.Rects = buf_rects + buf_rects_n;
         buf_rects_n += glyph_count;
         stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        int n = stbtt_PackFontRangesGatherRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
+        int n = DistanceFieldGlyphs ? ImFontAtlasSdfGatherRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects, DistanceFieldPadding) : stbtt_PackFontRangesGatherRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
         stbrp_pack_rects((stbrp_context*)spc.pack_info, tmp.Rects, n);
 
         // Extend texture height
@@ -1367,14 +1838,43 @@ bool    ImFontAtlas::Build()
     spc.height = TexHeight;
 
     // Second pass: render characters
+    // Packed rectangles are disjoint so we split ranges into jobs which can run concurrently with BuildRunJobsFn. The output is the same in any order.
+    ImFontBuildRenderJobs jobs;
+    jobs.PackContext = spc;
+    jobs.SdfPadding = DistanceFieldGlyphs ? DistanceFieldPadding : 0;
     for (int input_i = 0; input_i < ConfigData.Size; input_i++)
     {
-        ImFontConfig& cfg = ConfigData[input_i];
         ImFontTempBuildData& tmp = tmp_array[input_i];
-        stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        stbtt_PackFontRangesRenderIntoRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
+        stbrp_rect* rects = tmp.Rects;
+        for (int i = 0; i < tmp.RangesCount; i++)
+        {
+            const stbtt_pack_range& range = tmp.Ranges[i];
+            for (int char_idx = 0; char_idx < range.num_chars; char_idx += IM_FONT_BUILD_JOB_GLYPHS)
+            {
+                ImFontBuildRenderJob job;
+                job.FontInfo = &tmp.FontInfo;
+                job.Range = range;
+                job.Range.first_unicode_codepoint_in_range += char_idx;
+                job.Range.num_chars = ImMin(range.num_chars - char_idx, IM_FONT_BUILD_JOB_GLYPHS);
+                job.Range.chardata_for_range += char_idx;
+                job.Rects = rects + char_idx;
+                jobs.Jobs.push_back(job);
+            }
+            rects += range.num_chars;
+        }
         tmp.Rects = NULL;
     }
+    if (BuildRunJobsFn && jobs.Jobs.Size > 1)
+    {
+        jobs.Allocator.AllocFn = ImGui::GetIO().MemAllocFn;
+        jobs.Allocator.FreeFn = ImGui::GetIO().MemFreeFn;
+        BuildRunJobsFn(ImFontAtlasBuildRenderJob, &jobs, jobs.Jobs.Size, BuildRunJobsUserData);
+    }
+    else
+    {
+        for (int job_i = 0; job_i < jobs.Jobs.Size; job_i++)
+            ImFontAtlasBuildRenderJob(&jobs, job_i);
+    }
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -1666,6 +2166,566 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesThai()
     return &ranges[0];
 }
 
+//-----------------------------------------------------------------------------
+// ImFontAtlas dynamic glyphs
+//-----------------------------------------------------------------------------
+// With DynamicGlyphs, Build() only creates the texture with our custom data and the space/fallback glyphs. Codepoints of the source ranges are marked as
+// pending in ImFont::IndexLookup[] and FindGlyph() rasterizes and packs them on first use, into the same stbtt_pack_context kept alive across frames.
+// When a glyph doesn't fit, it is added without pixels and the next NewFrame() repacks all glyphs from most to least recently used, dropping the rest.
+//-----------------------------------------------------------------------------
+
+#define IM_GLYPH_INDEX_PENDING  ((unsigned short)-2)    // ImFont::IndexLookup[] value for a codepoint in the font ranges which hasn't been loaded yet
+
+struct ImFontAtlasDynamicData
+{
+    stbtt_pack_context          PackContext;        // Packing into TexPixelsAlpha8
+    ImVector<stbtt_fontinfo>    FontInfo;           // Per ImFontAtlas::ConfigData[] entry
+    ImVector<float>             FontAscent;         // Per ImFontAtlas::ConfigData[] entry
+    bool                        NeedCompaction;     // A glyph didn't fit in the texture
+    int                         DirtyX0, DirtyY0, DirtyX1, DirtyY1; // Area modified since last call to GetTexDataDirtyRect(), empty if DirtyX0 >= DirtyX1
+
+    ImFontAtlasDynamicData()    { memset(&PackContext, 0, sizeof(PackContext)); NeedCompaction = false; DirtyX0 = DirtyY0 = DirtyX1 = DirtyY1 = 0; }
+};
+
+struct ImFontDynamicGlyphRef
+{
+    ImFont*     Font;
+    ImWchar     Codepoint;
+    bool        Pinned;             // Space and fallback characters are always kept
+    int         LastUsedFrame;
+    int         Order;
+};
+
+static int ImFontDynamicGlyphRefComparer(const void* lhs, const void* rhs)
+{
+    const ImFontDynamicGlyphRef* a = (const ImFontDynamicGlyphRef*)lhs;
+    const ImFontDynamicGlyphRef* b = (const ImFontDynamicGlyphRef*)rhs;
+    if (a->Pinned != b->Pinned)
+        return a->Pinned ? -1 : +1;
+    if (a->LastUsedFrame != b->LastUsedFrame)
+        return (a->LastUsedFrame > b->LastUsedFrame) ? -1 : +1;
+    return a->Order - b->Order;
+}
+
+static bool ImGlyphRangesContain(const ImWchar* ranges, ImWchar c)
+{
+    for (; ranges[0] && ranges[1]; ranges += 2)
+        if (c >= ranges[0] && c <= ranges[1])
+            return true;
+    return false;
+}
+
+static void ImFontAtlasDynamicDestroy(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicData* data = atlas->DynamicData;
+    if (!data)
+        return;
+    stbtt_PackEnd(&data->PackContext);
+    data->~ImFontAtlasDynamicData();
+    ImGui::MemFree(data);
+    atlas->DynamicData = NULL;
+}
+
+static void ImFontAtlasDynamicMarkDirty(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    ImFontAtlasDynamicData* data = atlas->DynamicData;
+    const int x1 = ImMin(x + w, atlas->TexWidth), y1 = ImMin(y + h, atlas->TexHeight);
+    if (data->DirtyX0 >= data->DirtyX1)
+    {
+        data->DirtyX0 = x; data->DirtyY0 = y; data->DirtyX1 = x1; data->DirtyY1 = y1;
+    }
+    else
+    {
+        data->DirtyX0 = ImMin(data->DirtyX0, x); data->DirtyY0 = ImMin(data->DirtyY0, y);
+        data->DirtyX1 = ImMax(data->DirtyX1, x1); data->DirtyY1 = ImMax(data->DirtyY1, y1);
+    }
+
+    // Keep the RGBA32 copy in sync if it has been requested
+    if (atlas->TexPixelsRGBA32)
+        for (int py = y; py < y1; py++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + py * atlas->TexWidth + x;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + py * atlas->TexWidth + x;
+            for (int n = x1 - x; n > 0; n--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+}
+
+// Clear the texture and restart packing with our custom data in the upper-left corner
+static void ImFontAtlasDynamicResetTexture(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicData* data = atlas->DynamicData;
+    stbtt_PackEnd(&data->PackContext);
+    stbtt_PackBegin(&data->PackContext, atlas->TexPixelsAlpha8, atlas->TexWidth, atlas->TexHeight, 0, 1, NULL);
+
+    ImVector<stbrp_rect> extra_rects;
+    atlas->RenderCustomTexData(0, &extra_rects);
+    stbrp_pack_rects((stbrp_context*)data->PackContext.pack_info, &extra_rects[0], extra_rects.Size);
+    IM_ASSERT(extra_rects[0].was_packed);   // TexDesiredWidth is too small
+    atlas->RenderCustomTexData(1, &extra_rects);
+    ImFontAtlasDynamicMarkDirty(atlas, 0, 0, atlas->TexWidth, atlas->TexHeight);
+}
+
+static bool ImFontAtlasDynamicBuild(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicData* data = (ImFontAtlasDynamicData*)ImGui::MemAlloc(sizeof(ImFontAtlasDynamicData));
+    IM_PLACEMENT_NEW(data) ImFontAtlasDynamicData();
+    atlas->DynamicData = data;
+
+    // Initialize font information early (so we can error without any cleanup)
+    data->FontInfo.resize(atlas->ConfigData.Size);
+    data->FontAscent.resize(atlas->ConfigData.Size);
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[input_i];
+        IM_ASSERT(cfg.DstFont && (!cfg.DstFont->IsLoaded() || cfg.DstFont->ContainerAtlas == atlas));
+        const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+        IM_ASSERT(font_offset >= 0);
+        if (!stbtt_InitFont(&data->FontInfo[input_i], (unsigned char*)cfg.FontData, font_offset))
+        {
+            ImFontAtlasDynamicDestroy(atlas);
+            return false;
+        }
+        data->FontInfo[input_i].userdata = NULL;
+        if (!cfg.GlyphRanges)
+            cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
+    }
+
+    // Create texture. The size is fixed as it can't be known in advance.
+    atlas->TexWidth = (atlas->TexDesiredWidth > 0) ? atlas->TexDesiredWidth : 1024;
+    atlas->TexHeight = atlas->TexWidth;
+    atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc(atlas->TexWidth * atlas->TexHeight);
+    ImFontAtlasDynamicResetTexture(atlas);
+
+    // Setup ImFont without any glyph
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[input_i];
+        ImFont* dst_font = cfg.DstFont;
+
+        float font_scale = stbtt_ScaleForPixelHeight(&data->FontInfo[input_i], cfg.SizePixels);
+        int unscaled_ascent, unscaled_descent, unscaled_line_gap;
+        stbtt_GetFontVMetrics(&data->FontInfo[input_i], &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
+
+        float ascent = unscaled_ascent * font_scale;
+        float descent = unscaled_descent * font_scale;
+        data->FontAscent[input_i] = ascent;
+        if (!cfg.MergeMode)
+        {
+            dst_font->ContainerAtlas = atlas;
+            dst_font->ConfigData = &cfg;
+            dst_font->ConfigDataCount = 0;
+            dst_font->FontSize = cfg.SizePixels;
+            dst_font->Ascent = ascent;
+            dst_font->Descent = descent;
+            dst_font->Glyphs.resize(0);
+            dst_font->GlyphsLastUsedFrame.resize(0);
+        }
+        dst_font->ConfigDataCount++;
+        dst_font->FallbackGlyph = NULL;
+    }
+
+    // Index all codepoints as pending, this loads the space and fallback glyphs
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        if (!atlas->ConfigData[input_i].MergeMode)
+            atlas->ConfigData[input_i].DstFont->BuildLookupTable();
+
+    // Build() output is uploaded as a whole
+    data->DirtyX0 = data->DirtyY0 = data->DirtyX1 = data->DirtyY1 = 0;
+    return true;
+}
+
+// Rasterize and pack the glyph for 'c' from the first source of 'font' which has it in its ranges.
+// Return false if it doesn't fit in the texture, in which case only the glyph metrics are set.
+static bool ImFontAtlasDynamicRasterizeGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c, ImFont::Glyph* out_glyph)
+{
+    ImFontAtlasDynamicData* data = atlas->DynamicData;
+    int src_n = 0;
+    while (src_n + 1 < font->ConfigDataCount && !ImGlyphRangesContain(font->ConfigData[src_n].GlyphRanges, c))
+        src_n++;
+    const ImFontConfig& cfg = font->ConfigData[src_n];
+    const int input_i = (int)(&cfg - atlas->ConfigData.Data);
+    const stbtt_fontinfo* font_info = &data->FontInfo[input_i];
+
+    stbtt_packedchar pc;
+    stbtt_pack_range range;
+    memset(&range, 0, sizeof(range));
+    range.font_size = cfg.SizePixels;
+    range.first_unicode_codepoint_in_range = c;
+    range.num_chars = 1;
+    range.chardata_for_range = &pc;
+
+    stbrp_rect rect;
+    stbtt_pack_context& spc = data->PackContext;
+    stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
+    if (atlas->DistanceFieldGlyphs)
+        ImFontAtlasSdfGatherRects(&spc, font_info, &range, 1, &rect, atlas->DistanceFieldPadding);
+    else
+        stbtt_PackFontRangesGatherRects(&spc, font_info, &range, 1, &rect);
+    stbrp_pack_rects((stbrp_context*)spc.pack_info, &rect, 1);
+
+    ImFont::Glyph& glyph = *out_glyph;
+    memset(&glyph, 0, sizeof(glyph));
+    glyph.Codepoint = c;
+    if (!rect.was_packed)
+    {
+        // Same advance as stbtt_PackFontRangesRenderIntoRects(), without any pixels
+        int advance, left_side_bearing;
+        stbtt_GetCodepointHMetrics(font_info, c, &advance, &left_side_bearing);
+        glyph.XAdvance = (advance * stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) + cfg.GlyphExtraSpacing.x);
+        if (cfg.PixelSnapH)
+            glyph.XAdvance = (float)(int)(glyph.XAdvance + 0.5f);
+        return false;
+    }
+    if (atlas->DistanceFieldGlyphs)
+        ImFontAtlasSdfRenderIntoRects(&spc, font_info, &range, 1, &rect, atlas->DistanceFieldPadding);
+    else
+        stbtt_PackFontRangesRenderIntoRects(&spc, font_info, &range, 1, &rect);
+    ImFontAtlasDynamicMarkDirty(atlas, rect.x, rect.y, rect.w, rect.h);
+
+    // Same as the third pass of ImFontAtlas::Build()
+    stbtt_aligned_quad q;
+    float dummy_x = 0.0f, dummy_y = 0.0f;
+    stbtt_GetPackedQuad(&pc, atlas->TexWidth, atlas->TexHeight, 0, &dummy_x, &dummy_y, &q, 0);
+    float off_y = (cfg.MergeMode && cfg.MergeGlyphCenterV) ? (data->FontAscent[input_i] - font->Ascent) * 0.5f : 0.0f;
+    glyph.X0 = q.x0; glyph.Y0 = q.y0; glyph.X1 = q.x1; glyph.Y1 = q.y1;
+    glyph.U0 = q.s0; glyph.V0 = q.t0; glyph.U1 = q.s1; glyph.V1 = q.t1;
+    glyph.Y0 += (float)(int)(font->Ascent + off_y + 0.5f);
+    glyph.Y1 += (float)(int)(font->Ascent + off_y + 0.5f);
+    glyph.XAdvance = (pc.xadvance + cfg.GlyphExtraSpacing.x);  // Bake spacing into XAdvance
+    if (cfg.PixelSnapH)
+        glyph.XAdvance = (float)(int)(glyph.XAdvance + 0.5f);
+    return true;
+}
+
+static const ImFont::Glyph* ImFontAddDynamicGlyph(const ImFont* font, const ImFont::Glyph& glyph, int last_used_frame)
+{
+    IM_ASSERT(font->Glyphs.Size < IM_GLYPH_INDEX_PENDING);
+    IM_ASSERT(font->Glyphs.Size < font->Glyphs.Capacity);   // Reserved by BuildLookupTable() so glyph pointers returned by FindGlyph() stay valid
+    font->Glyphs.push_back(glyph);
+
+    const int glyph_idx = font->Glyphs.Size - 1;
+    font->GrowIndex(glyph.Codepoint + 1);
+    font->IndexLookup[glyph.Codepoint] = (unsigned short)glyph_idx;
+    font->IndexXAdvance[glyph.Codepoint] = glyph.XAdvance;
+
+    // Glyphs added by BuildLookupTable() (TAB) don't have an entry yet
+    for (int n = font->GlyphsLastUsedFrame.Size; n < font->Glyphs.Size; n++)
+        font->GlyphsLastUsedFrame.push_back(last_used_frame);
+    font->GlyphsLastUsedFrame[glyph_idx] = last_used_frame;
+    return &font->Glyphs[glyph_idx];
+}
+
+const ImFont::Glyph* ImFont::LoadDynamicGlyph(ImWchar c) const
+{
+    IM_ASSERT(c < IndexLookup.Size && IndexLookup[c] == IM_GLYPH_INDEX_PENDING);
+    ImFontAtlasDynamicData* data = ContainerAtlas->DynamicData;
+    if (!data)  // Input data has been cleared, we can't load anymore
+    {
+        IndexLookup[c] = (unsigned short)-1;
+        IndexXAdvance[c] = FallbackXAdvance;
+        return FallbackGlyph;
+    }
+
+    // When the texture is full we still add the glyph (without pixels for this frame) so its metrics are correct, and it will be packed again after eviction.
+    Glyph glyph;
+    if (!ImFontAtlasDynamicRasterizeGlyph(ContainerAtlas, this, c, &glyph))
+        data->NeedCompaction = true;
+    return ImFontAddDynamicGlyph(this, glyph, ContainerAtlas->DynamicFrameCount);
+}
+
+bool    ImFontAtlas::GetTexDataDirtyRect(int* out_x, int* out_y, int* out_w, int* out_h)
+{
+    ImFontAtlasDynamicData* data = DynamicData;
+    if (!data || data->DirtyX0 >= data->DirtyX1)
+        return false;
+    *out_x = data->DirtyX0;
+    *out_y = data->DirtyY0;
+    *out_w = data->DirtyX1 - data->DirtyX0;
+    *out_h = data->DirtyY1 - data->DirtyY0;
+    data->DirtyX0 = data->DirtyY0 = data->DirtyX1 = data->DirtyY1 = 0;
+    return true;
+}
+
+void    ImFontAtlas::UpdateDynamicGlyphs()
+{
+    ImFontAtlasDynamicData* data = DynamicData;
+    if (!data)
+        return;
+    DynamicFrameCount++;
+    if (!data->NeedCompaction)
+        return;
+    data->NeedCompaction = false;
+
+    // Sort glyphs of all fonts from most to least recently used
+    ImVector<ImFontDynamicGlyphRef> refs;
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        ImFont* font = Fonts[font_i];
+        if (font->ContainerAtlas != this)
+            continue;
+        for (int glyph_i = 0; glyph_i < font->Glyphs.Size; glyph_i++)
+        {
+            ImFontDynamicGlyphRef ref;
+            ref.Font = font;
+            ref.Codepoint = font->Glyphs[glyph_i].Codepoint;
+            ref.Pinned = (ref.Codepoint == ' ' || ref.Codepoint == font->FallbackChar);
+            ref.LastUsedFrame = (glyph_i < font->GlyphsLastUsedFrame.Size) ? font->GlyphsLastUsedFrame[glyph_i] : 0;
+            ref.Order = refs.Size;
+            if (ref.Codepoint != '\t')  // Created by BuildLookupTable()
+                refs.push_back(ref);
+        }
+        font->Glyphs.resize(0);
+        font->GlyphsLastUsedFrame.resize(0);
+        font->IndexXAdvance.resize(0);
+        font->IndexLookup.resize(0);
+        font->FallbackGlyph = NULL;
+    }
+    if (!refs.empty())
+        qsort(&refs[0], (size_t)refs.Size, sizeof(ImFontDynamicGlyphRef), ImFontDynamicGlyphRefComparer);
+
+    // Repack into a blank texture. Glyphs used during the last frame are kept as long as they fit, older ones only until half of the texture is used,
+    // so there is room for new glyphs and we don't repack again on the next frame. Evicted glyphs will be loaded again when used.
+    ImFontAtlasDynamicResetTexture(this);
+    const float max_area_for_old_glyphs = TexWidth * TexHeight * 0.5f;
+    float area = 0.0f;
+    for (int ref_i = 0; ref_i < refs.Size; ref_i++)
+    {
+        const ImFontDynamicGlyphRef& ref = refs[ref_i];
+        if (!ref.Pinned && ref.LastUsedFrame < DynamicFrameCount - 1 && area > max_area_for_old_glyphs)
+            break;
+        ImFont::Glyph glyph;
+        if (!ImFontAtlasDynamicRasterizeGlyph(this, ref.Font, ref.Codepoint, &glyph))
+            break;
+        ImFontAddDynamicGlyph(ref.Font, glyph, ref.LastUsedFrame);
+        area += (glyph.U1 - glyph.U0) * TexWidth * (glyph.V1 - glyph.V0) * TexHeight;
+    }
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        if (Fonts[font_i]->ContainerAtlas == this)
+            Fonts[font_i]->BuildLookupTable();
+    TexGeneration++;
+}
+
+//-----------------------------------------------------------------------------
+// ImFontAtlas build cache
+//-----------------------------------------------------------------------------
+// Layout: ImFontAtlasCacheHeader, then for each font an ImFontAtlasCacheFont followed by its glyphs, then the Alpha8 pixels.
+// Lookup tables are rebuilt on load. Data is written in native byte order and layout, so a cache is only valid for the same build of the library.
+//-----------------------------------------------------------------------------
+
+#define IM_FONT_ATLAS_CACHE_VERSION     1
+
+struct ImFontAtlasCacheHeader
+{
+    char        Magic[4];               // "IMFA"
+    int         Version;                // IM_FONT_ATLAS_CACHE_VERSION
+    int         GlyphSize;              // sizeof(ImFont::Glyph)
+    ImU32       Key;                    // GetBuildCacheKey()
+    int         TexWidth, TexHeight;
+    float       TexUvWhitePixelX, TexUvWhitePixelY;    // Plain floats so the header can be cleared with memset()
+    int         FontsCount;
+};
+
+struct ImFontAtlasCacheFont
+{
+    float       FontSize;
+    float       Ascent, Descent;
+    int         GlyphsCount;
+};
+
+ImU32   ImFontAtlas::GetBuildCacheKey()
+{
+    int atlas_settings[3] = { TexDesiredWidth, DistanceFieldGlyphs ? 1 : 0, DistanceFieldPadding };
+    ImU32 key = ImHash(atlas_settings, sizeof(atlas_settings), IM_FONT_ATLAS_CACHE_VERSION);
+    for (int input_i = 0; input_i < ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = ConfigData[input_i];
+        IM_ASSERT(cfg.FontData != NULL && cfg.FontDataSize > 0);    // Input data has been cleared
+
+        // Hash settings which affect Build() output, copied to avoid hashing padding bytes
+        struct { int FontNo; float SizePixels; int OversampleH, OversampleV; int PixelSnapH; float GlyphExtraSpacingX, GlyphExtraSpacingY; int MergeMode, MergeGlyphCenterV; } settings;
+        memset(&settings, 0, sizeof(settings));
+        settings.FontNo = cfg.FontNo;
+        settings.SizePixels = cfg.SizePixels;
+        settings.OversampleH = cfg.OversampleH;
+        settings.OversampleV = cfg.OversampleV;
+        settings.PixelSnapH = cfg.PixelSnapH ? 1 : 0;
+        settings.GlyphExtraSpacingX = cfg.GlyphExtraSpacing.x;
+        settings.GlyphExtraSpacingY = cfg.GlyphExtraSpacing.y;
+        settings.MergeMode = cfg.MergeMode ? 1 : 0;
+        settings.MergeGlyphCenterV = cfg.MergeGlyphCenterV ? 1 : 0;
+        key = ImHash(&settings, sizeof(settings), key);
+        key = ImHash(cfg.FontData, cfg.FontDataSize, key);
+
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : GetGlyphRangesDefault();
+        int ranges_count = 0;
+        while (ranges[ranges_count * 2] && ranges[ranges_count * 2 + 1])
+            ranges_count++;
+        key = ImHash(&ranges_count, sizeof(ranges_count), key);
+        if (ranges_count > 0)
+            key = ImHash(ranges, ranges_count * 2 * (int)sizeof(ImWchar), key);
+    }
+    return key;
+}
+
+void*   ImFontAtlas::SaveBuildCache(int* out_size)
+{
+    *out_size = 0;
+    IM_ASSERT(!DynamicGlyphs);  // Dynamic glyphs are loaded as they are used, there's nothing worth caching
+    if (DynamicGlyphs)
+        return NULL;
+    unsigned char* pixels;
+    int width, height;
+    GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    int data_size = (int)sizeof(ImFontAtlasCacheHeader) + width * height;
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        data_size += (int)sizeof(ImFontAtlasCacheFont) + Fonts[font_i]->Glyphs.Size * (int)sizeof(ImFont::Glyph);
+    char* data = (char*)ImGui::MemAlloc((size_t)data_size);
+    char* p = data;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "IMFA", 4);
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    header.GlyphSize = (int)sizeof(ImFont::Glyph);
+    header.Key = GetBuildCacheKey();
+    header.TexWidth = width;
+    header.TexHeight = height;
+    header.TexUvWhitePixelX = TexUvWhitePixel.x;
+    header.TexUvWhitePixelY = TexUvWhitePixel.y;
+    header.FontsCount = Fonts.Size;
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        const ImFont* font = Fonts[font_i];
+        ImFontAtlasCacheFont cache_font;
+        cache_font.FontSize = font->FontSize;
+        cache_font.Ascent = font->Ascent;
+        cache_font.Descent = font->Descent;
+        cache_font.GlyphsCount = font->Glyphs.Size;
+        memcpy(p, &cache_font, sizeof(cache_font));
+        p += sizeof(cache_font);
+        memcpy(p, font->Glyphs.Data, font->Glyphs.Size * sizeof(ImFont::Glyph));
+        p += font->Glyphs.Size * sizeof(ImFont::Glyph);
+    }
+    memcpy(p, pixels, width * height);
+    p += width * height;
+    IM_ASSERT(p == data + data_size);
+
+    *out_size = data_size;
+    return data;
+}
+
+bool    ImFontAtlas::LoadBuildCache(const void* data, int data_size)
+{
+    IM_ASSERT(ConfigData.Size > 0);
+    if (DynamicGlyphs || data_size < (int)sizeof(ImFontAtlasCacheHeader))
+        return false;
+
+    // Validate everything before modifying the atlas
+    ImFontAtlasCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.Magic, "IMFA", 4) != 0 || header.Version != IM_FONT_ATLAS_CACHE_VERSION || header.GlyphSize != (int)sizeof(ImFont::Glyph))
+        return false;
+    if (header.FontsCount != Fonts.Size || header.TexWidth <= 0 || header.TexHeight <= 0 || header.Key != GetBuildCacheKey())
+        return false;
+    const char* fonts_data = (const char*)data + sizeof(header);
+    const char* p = fonts_data;
+    const char* p_end = (const char*)data + data_size;
+    for (int font_i = 0; font_i < header.FontsCount; font_i++)
+    {
+        ImFontAtlasCacheFont cache_font;
+        if (p_end - p < (int)sizeof(cache_font))
+            return false;
+        memcpy(&cache_font, p, sizeof(cache_font));
+        p += sizeof(cache_font);
+        if (cache_font.GlyphsCount < 0 || (p_end - p) / (int)sizeof(ImFont::Glyph) < cache_font.GlyphsCount)
+            return false;
+        p += cache_font.GlyphsCount * sizeof(ImFont::Glyph);
+    }
+    if (p_end - p != header.TexWidth * header.TexHeight)
+        return false;
+
+    // Setup texture
+    TexID = NULL;
+    ImFontAtlasDynamicDestroy(this);
+    ClearTexData();
+    TexWidth = header.TexWidth;
+    TexHeight = header.TexHeight;
+    TexUvWhitePixel = ImVec2(header.TexUvWhitePixelX, header.TexUvWhitePixelY);
+    TexGeneration++;
+    TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc(TexWidth * TexHeight);
+    memcpy(TexPixelsAlpha8, p, TexWidth * TexHeight);
+
+    // Setup fonts the same way as Build()
+    for (int input_i = 0; input_i < ConfigData.Size; input_i++)
+    {
+        ImFontConfig& cfg = ConfigData[input_i];
+        IM_ASSERT(cfg.DstFont && (!cfg.DstFont->IsLoaded() || cfg.DstFont->ContainerAtlas == this));
+        if (!cfg.GlyphRanges)
+            cfg.GlyphRanges = GetGlyphRangesDefault();
+        if (!cfg.MergeMode)
+        {
+            cfg.DstFont->ContainerAtlas = this;
+            cfg.DstFont->ConfigData = &cfg;
+            cfg.DstFont->ConfigDataCount = 0;
+        }
+        cfg.DstFont->ConfigDataCount++;
+    }
+    p = fonts_data;
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        ImFont* font = Fonts[font_i];
+        ImFontAtlasCacheFont cache_font;
+        memcpy(&cache_font, p, sizeof(cache_font));
+        p += sizeof(cache_font);
+        font->FontSize = cache_font.FontSize;
+        font->Ascent = cache_font.Ascent;
+        font->Descent = cache_font.Descent;
+        font->Glyphs.resize(cache_font.GlyphsCount);
+        memcpy(font->Glyphs.Data, p, cache_font.GlyphsCount * sizeof(ImFont::Glyph));
+        p += cache_font.GlyphsCount * sizeof(ImFont::Glyph);
+        font->FallbackGlyph = NULL;
+        font->BuildLookupTable();
+    }
+
+    // Setup mouse cursors. Our custom data rectangle is the one containing the white pixel, rendering it again doesn't modify the texture.
+    ImVector<stbrp_rect> extra_rects;
+    RenderCustomTexData(0, &extra_rects);
+    extra_rects[0].x = (stbrp_coord)(TexUvWhitePixel.x * TexWidth);
+    extra_rects[0].y = (stbrp_coord)(TexUvWhitePixel.y * TexHeight);
+    RenderCustomTexData(1, &extra_rects);
+    return true;
+}
+
+bool    ImFontAtlas::SaveBuildCacheToFile(const char* filename)
+{
+    int data_size = 0;
+    void* data = SaveBuildCache(&data_size);
+    if (!data)
+        return false;
+    FILE* f = fopen(filename, "wb");
+    bool ret = f && fwrite(data, 1, (size_t)data_size, f) == (size_t)data_size;
+    if (f)
+        ret &= (fclose(f) == 0);
+    ImGui::MemFree(data);
+    return ret;
+}
+
+bool    ImFontAtlas::LoadBuildCacheFromFile(const char* filename)
+{
+    int data_size = 0;
+    void* data = ImLoadFileToMemory(filename, "rb", &data_size, 0);
+    if (!data)
+        return false;
+    bool ret = LoadBuildCache(data, data_size);
+    ImGui::MemFree(data);
+    return ret;
+}
+
 //-----------------------------------------------------------------------------
 // ImFont
 //-----------------------------------------------------------------------------
@@ -1703,6 +2763,7 @@ void    ImFont::Clear()
     FallbackXAdvance = 0.0f;
     IndexXAdvance.clear();
     IndexLookup.clear();
+    GlyphsLastUsedFrame.clear();
 }
 
 void ImFont::BuildLookupTable()
@@ -1711,7 +2772,22 @@ void ImFont::BuildLookupTable()
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
 
-    IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    // With dynamic glyphs, every codepoint of the source ranges is indexed. The ones not loaded yet are marked as pending and loaded by FindGlyph().
+    // Room for all of them (+ TAB) is reserved, so loading a glyph never reallocates Glyphs and invalidates pointers returned by FindGlyph().
+    const bool dynamic_glyphs = ContainerAtlas && ContainerAtlas->DynamicData;
+    if (dynamic_glyphs)
+    {
+        int glyphs_count = 1;
+        for (int n = 0; n < ConfigDataCount; n++)
+            for (const ImWchar* in_range = ConfigData[n].GlyphRanges; in_range[0] && in_range[1]; in_range += 2)
+            {
+                max_codepoint = ImMax(max_codepoint, (int)in_range[1]);
+                glyphs_count += in_range[1] - in_range[0] + 1;
+            }
+        Glyphs.reserve(ImMin(glyphs_count, (int)IM_GLYPH_INDEX_PENDING));
+    }
+
+    IM_ASSERT(Glyphs.Size < 0xFFFE); // -1 and -2 are reserved
     IndexXAdvance.clear();
     IndexLookup.clear();
     GrowIndex(max_codepoint + 1);
@@ -1721,6 +2797,12 @@ void ImFont::BuildLookupTable()
         IndexXAdvance[codepoint] = Glyphs[i].XAdvance;
         IndexLookup[codepoint] = (unsigned short)i;
     }
+    if (dynamic_glyphs)
+        for (int n = 0; n < ConfigDataCount; n++)
+            for (const ImWchar* in_range = ConfigData[n].GlyphRanges; in_range[0] && in_range[1]; in_range += 2)
+                for (int codepoint = in_range[0]; codepoint <= in_range[1]; codepoint++)
+                    if (IndexLookup[codepoint] == (unsigned short)-1)
+                        IndexLookup[codepoint] = IM_GLYPH_INDEX_PENDING;
 
     // Create a glyph to handle TAB
     // FIXME: Needs proper TAB handling but it needs to be contextualized (or we could arbitrary say that each string starts at "column 0" ?)
@@ -1740,7 +2822,7 @@ void ImFont::BuildLookupTable()
     FallbackGlyph = FindGlyph(FallbackChar);
     FallbackXAdvance = FallbackGlyph ? FallbackGlyph->XAdvance : 0.0f;
     for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexXAdvance[i] < 0.0f)
+        if (IndexXAdvance[i] < 0.0f && IndexLookup[i] != IM_GLYPH_INDEX_PENDING)
             IndexXAdvance[i] = FallbackXAdvance;
 }
 
@@ -1750,7 +2832,7 @@ void ImFont::SetFallbackChar(ImWchar c)
     BuildLookupTable();
 }
 
-void ImFont::GrowIndex(int new_size)
+void ImFont::GrowIndex(int new_size) const
 {
     IM_ASSERT(IndexXAdvance.Size == IndexLookup.Size);
     int old_size = IndexLookup.Size;
@@ -1785,8 +2867,14 @@ const ImFont::Glyph* ImFont::FindGlyph(unsigned short c) const
     if (c < IndexLookup.Size)
     {
         const unsigned short i = IndexLookup[c];
-        if (i != (unsigned short)-1)
+        if (i < IM_GLYPH_INDEX_PENDING)
+        {
+            if (i < GlyphsLastUsedFrame.Size)
+                GlyphsLastUsedFrame.Data[i] = ContainerAtlas->DynamicFrameCount;
             return &Glyphs.Data[i];
+        }
+        if (i == IM_GLYPH_INDEX_PENDING)
+            return LoadDynamicGlyph(c);
     }
     return FallbackGlyph;
 }
@@ -1844,7 +2932,10 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexXAdvance.Size ? IndexXAdvance[(int)c] : FallbackXAdvance) * scale;
+        float char_width = ((int)c < IndexXAdvance.Size ? IndexXAdvance[(int)c] : FallbackXAdvance);
+        if (char_width < 0.0f)  // Dynamic glyph not loaded yet
+            char_width = FindGlyph((unsigned short)c)->XAdvance;
+        char_width *= scale;
         if (ImCharIsSpace(c))
         {
             if (inside_word)
@@ -1960,7 +3051,10 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexXAdvance.Size ? IndexXAdvance[(int)c] : FallbackXAdvance) * scale;
+        float char_width = ((int)c < IndexXAdvance.Size ? IndexXAdvance[(int)c] : FallbackXAdvance);
+        if (char_width < 0.0f)  // Dynamic glyph not loaded yet
+            char_width = FindGlyph((unsigned short)c)->XAdvance;
+        char_width *= scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -2147,10 +3241,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                     {
                         idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
                         idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
-                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                        vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = col; vtx_write[0].uv = ImVec2(u1, v1);
+                        vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = col; vtx_write[1].uv = ImVec2(u2, v1);
+                        vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = col; vtx_write[2].uv = ImVec2(u2, v2);
+                        vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = col; vtx_write[3].uv = ImVec2(u1, v2);
                         vtx_write += 4;
                         vtx_current_idx += 4;
                         idx_write += 6;
@@ -2176,6 +3270,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 //-----------------------------------------------------------------------------
 // Compressed with stb_compress() then converted to a C array.
 // Use the program in extra_fonts/binary_to_compressed_c.cpp to create the array from a TTF file.
+// The faster LZ4-style format it writes with -lz4 is decoded by ImLz4Decompress() below.
 // Decompression from stb.h (public domain) by Sean Barrett https://github.com/nothings/stb/blob/master/stb.h
 //-----------------------------------------------------------------------------
 
@@ -2290,6 +3385,89 @@ static unsigned int stb_decompress(unsigned char *output, unsigned char *i, unsi
     }
 }
 
+// LZ4-style block format, written by binary_to_compressed_c.cpp -lz4: "ImL4" signature, 32-bit little-endian decompressed size, then a list of sequences:
+//   [token: literals count (4 bits) | match length - 4 (4 bits)] [more literals count] [literals] [16-bit little-endian match offset] [more match length]
+// A count of 15 in the token continues with bytes added to it, until one is < 255. The last sequence has literals only.
+// Unlike stb_decompress() there's no checksum, but reads and writes are bound-checked. Away from the end of the output, short literals and matches
+// are copied 8 or 16 bytes at a time (the format guarantees the last 5 bytes are literals and the last match starts 12 bytes before the end).
+static bool ImLz4IsCompressed(const unsigned char* input, unsigned int length)
+{
+    return length >= 8 && input[0] == 'I' && input[1] == 'm' && input[2] == 'L' && input[3] == '4';
+}
+
+static unsigned int ImLz4DecompressLength(const unsigned char* input)
+{
+    return input[4] + (input[5] << 8) + (input[6] << 16) + ((unsigned int)input[7] << 24);
+}
+
+static unsigned int ImLz4Decompress(unsigned char* output, const unsigned char* input, unsigned int length)
+{
+    if (!ImLz4IsCompressed(input, length))
+        return 0;
+    const unsigned int olen = ImLz4DecompressLength(input);
+    const unsigned char* ip = input + 8;
+    const unsigned char* ip_end = input + length;   // Data may be followed by padding (e.g. after Decode85), we stop when the output is complete
+    unsigned char* op = output;
+    unsigned char* op_end = output + olen;
+    while (ip < ip_end)
+    {
+        // Literals
+        const unsigned int token = *ip++;
+        unsigned int count = token >> 4;
+        if (count == 15)
+            for (unsigned int b = 255; b == 255; count += b)
+            {
+                if (ip == ip_end) return 0;
+                b = *ip++;
+            }
+        if (count > (unsigned int)(ip_end - ip) || count > (unsigned int)(op_end - op))
+            return 0;
+        if (count <= 16 && ip_end - ip >= 16 && op_end - op >= 16)
+            memcpy(op, ip, 16);
+        else
+            memcpy(op, ip, count);
+        op += count;
+        ip += count;
+        if (op == op_end)
+            return olen;
+
+        // Match
+        if (ip_end - ip < 2)
+            return 0;
+        const unsigned int offset = ip[0] + (ip[1] << 8);
+        ip += 2;
+        count = (token & 15) + 4;
+        if (count == 15 + 4)
+            for (unsigned int b = 255; b == 255; count += b)
+            {
+                if (ip == ip_end) return 0;
+                b = *ip++;
+            }
+        if (offset == 0 || offset > (unsigned int)(op - output) || count > (unsigned int)(op_end - op))
+            return 0;
+        const unsigned char* src = op - offset;
+        if (offset >= 8 && (unsigned int)(op_end - op) >= count + 8)
+        {
+            // Wide copy, each 8 bytes block only reads bytes that are already written
+            unsigned char* copy_end = op + count;
+            do { memcpy(op, src, 8); op += 8; src += 8; } while (op < copy_end);
+            op = copy_end;
+        }
+        else if (offset == 1)
+        {
+            memset(op, *src, count);
+            op += count;
+        }
+        else
+        {
+            while (count--) *op++ = *src++;
+        }
+        if (op == op_end)
+            return olen;
+    }
+    return 0;
+}
+
 //-----------------------------------------------------------------------------
 // ProggyClean.ttf
 // Copyright (c) 2004, 2005 Tristan Grimmer
@@ -40,6 +40,7 @@ struct ImGuiTextEditState;
 struct ImGuiIniData;
 struct ImGuiMouseCursorData;
 struct ImGuiPopupRef;
+struct ImGuiTable;
 struct ImGuiWindow;
 
 typedef int ImGuiLayoutType;      // enum ImGuiLayoutType_
@@ -68,8 +69,19 @@ namespace ImGuiStb
 //-----------------------------------------------------------------------------
 
 #ifndef GImGui
+#ifdef IMGUI_THREAD_LOCAL_CONTEXT
+#if defined(_MSC_VER)
+#define IM_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define IM_THREAD_LOCAL __thread            // Preferred over C++11 'thread_local' which may go through a wrapper function on every access from other translation units
+#else
+#define IM_THREAD_LOCAL thread_local
+#endif
+extern IM_THREAD_LOCAL ImGuiContext* GImGui; // Current implicit ImGui context pointer, per thread. Not exported with IMGUI_API as thread-local data can't be imported from a DLL.
+#else
 extern IMGUI_API ImGuiContext* GImGui;  // Current implicit ImGui context pointer
 #endif
+#endif
 
 //-----------------------------------------------------------------------------
 // Helpers
@@ -186,6 +198,16 @@ enum ImGuiLayoutType_
     ImGuiLayoutType_Horizontal
 };
 
+// Window state bits taking part in the size computations of Begin(), see ImGuiWindowLayoutInputs
+enum ImGuiWindowLayoutState_
+{
+    ImGuiWindowLayoutState_AutoFitX         = 1 << 0,
+    ImGuiWindowLayoutState_AutoFitY         = 1 << 1,
+    ImGuiWindowLayoutState_AutoFitOnlyGrows = 1 << 2,
+    ImGuiWindowLayoutState_Collapsed        = 1 << 3,
+    ImGuiWindowLayoutState_SizeSetByApi     = 1 << 4
+};
+
 enum ImGuiPlotType
 {
     ImGuiPlotType_Lines,
@@ -288,6 +310,35 @@ struct ImGuiColumnData
     //float     IndentX;
 };
 
+// Persistent data for BeginTable(). Column offsets are only rebuilt when a width changes, and visible ranges are found by binary search, so a frame only touches the visible cells.
+struct ImGuiTable
+{
+    ImGuiID             ID;
+    ImGuiTableFlags     Flags;
+    int                 ColumnsCount;
+    int                 RowsCount;
+    int                 FrozenColumns;
+    ImVector<float>     ColumnsWidth;           // Persistent. < 0.0f until set by TableSetupColumn() or by resizing
+    ImVector<float>     ColumnsOffset;          // ColumnsCount+1 cumulative widths, rebuilt when ColumnsOffsetDirty is set
+    bool                ColumnsOffsetDirty;
+    ImGuiWindow*        InnerWindow;            // Child window holding the scrolling region
+    ImGuiTable*         ParentTable;            // Table we were in when calling BeginTable()
+    ImRect              ViewRect;               // Visible area of the inner window, excluding scrollbars
+    float               RowHeight;
+    float               HeaderHeight;
+    float               RowsOriginY;            // Screen position of row RowsVisibleStart
+    int                 FrozenColumnsVisible;   // Frozen columns [0, FrozenColumnsVisible) are in view
+    int                 ColumnsVisibleStart;    // Scrolling columns [ColumnsVisibleStart, ColumnsVisibleEnd) are in view
+    int                 ColumnsVisibleEnd;
+    int                 RowsVisibleStart;       // Rows [RowsVisibleStart, RowsVisibleEnd) are in view
+    int                 RowsVisibleEnd;
+    int                 SetupColumn;            // Column of the next TableSetupColumn() call
+    int                 CellColumn;             // Current cell. CellColumn is -1 before the first TableNextCell() and ColumnsCount once done
+    int                 CellRow;
+
+    ImGuiTable()        { ID = 0; Flags = 0; ColumnsCount = RowsCount = FrozenColumns = 0; ColumnsOffsetDirty = true; InnerWindow = NULL; ParentTable = NULL; RowHeight = HeaderHeight = RowsOriginY = 0.0f; FrozenColumnsVisible = ColumnsVisibleStart = ColumnsVisibleEnd = RowsVisibleStart = RowsVisibleEnd = 0; SetupColumn = 0; CellColumn = -1; CellRow = 0; }
+};
+
 // Simple column measurement currently used for MenuItem() only. This is very short-sighted/throw-away code and NOT a generic helper.
 struct IMGUI_API ImGuiSimpleColumns
 {
@@ -358,6 +409,179 @@ struct ImGuiPopupRef
     ImGuiPopupRef(ImGuiID id, ImGuiWindow* parent_window, ImGuiID parent_menu_set, const ImVec2& mouse_pos) { PopupId = id; Window = NULL; ParentWindow = parent_window; ParentMenuSet = parent_menu_set; MousePosOnOpen = mouse_pos; }
 };
 
+// Index of the items of a zero-separated string passed to Combo(), so the string isn't scanned every frame
+struct ImGuiItemsIndex
+{
+    const char*     Items;              // Key: pointer to the string
+    ImVector<int>   Offsets;            // Offset of each item
+    int             Length;             // Offset of the final zero, checked every frame
+    int             LastFrameUsed;
+    int             LastFrameValidated; // Offsets are checked against the whole string on the first frame the popup is open
+
+    ImGuiItemsIndex() { Items = NULL; Length = 0; LastFrameUsed = LastFrameValidated = -1; }
+};
+
+// Display format parsed by ParseFormatPrecision()/FormatScalar(), cached per format pointer
+struct ImGuiParsedFormat
+{
+    const char*     Key;                // Format string pointer
+    char            Format[32];         // Copy of the format, compared on lookup as the same pointer may hold another format later (e.g. a stack buffer)
+    int             Precision;          // Result of ParseFormatPrecision(), -1 if none
+    char            Type;               // 'd', 'f' or 'g' if FormatScalar() can use a fast path, 0 otherwise
+    int             SpecPrecision;      // Precision of the 'f'/'g' conversion
+    int             SpecBegin, SpecEnd; // Conversion specification, the text around it is output verbatim (with "%%" unescaped)
+
+    ImGuiParsedFormat() { Key = NULL; Format[0] = 0; Precision = -1; Type = 0; SpecPrecision = 0; SpecBegin = SpecEnd = 0; }
+};
+
+// Glyph quad of a cached text layout, relative to the pixel-aligned text position
+struct ImGuiTextLayoutQuad
+{
+    float           X0, Y0, X1, Y1;
+    float           U0, V0, U1, V1;
+};
+
+// Cached layout of a short text: size as returned by CalcTextSize() and glyph quads as output by ImFont::RenderText()
+struct ImGuiTextLayout
+{
+    ImGuiID         Key;                // Hash of text, font, font size and wrap width
+    const ImFont*   Font;
+    float           FontSize;
+    float           WrapWidth;
+    int             TextOffset, TextLen;        // Copy of the text in ImGuiTextLayoutCache::TextData, to validate hash matches
+    int             QuadsOffset, QuadsCount;    // Glyph quads in ImGuiTextLayoutCache::QuadsData
+    float           SizeX, SizeY;
+    int             HashNext;           // Index of the next layout in the same hash bucket, or -1
+    int             LruPrev, LruNext;   // Index of the more/less recently used layout, or -1
+};
+
+// Per-context LRU cache of text layouts, so the same labels submitted every frame aren't decoded and measured again. Enabled with io.TextLayoutCacheSize > 0.
+struct ImGuiTextLayoutCache
+{
+    int             Capacity;           // == io.TextLayoutCacheSize when the cache was last cleared
+    ImVector<ImGuiTextLayout> Layouts;  // Plain data, text and quads are stored in TextData/QuadsData
+    ImVector<char>  TextData;
+    ImVector<ImGuiTextLayoutQuad> QuadsData;
+    int             TextDataUsed, QuadsDataUsed;    // Bytes/quads still referenced by a layout, the rest is compacted away when it outgrows them
+    ImVector<int>   Buckets;            // Key & (Buckets.Size-1) -> index of first layout in the bucket, or -1
+    int             LruHead, LruTail;   // Most and least recently used layouts
+    int             LastUsedIdx;        // Checked before hashing, as a label is typically measured then rendered right after
+    ImTextureID     FontTexID;          // The cache is cleared when the font atlas texture changes
+    int             FontTexWidth, FontTexHeight, FontTexGeneration;
+    ImDrawList      TempDrawList;       // Glyphs of new layouts are rendered here once
+    int             FrameHits, FrameMisses;
+    int             LastFrameHits, LastFrameMisses;
+
+    ImGuiTextLayoutCache() { Capacity = 0; TextDataUsed = QuadsDataUsed = 0; LruHead = LruTail = LastUsedIdx = -1; FontTexID = NULL; FontTexWidth = FontTexHeight = FontTexGeneration = 0; FrameHits = FrameMisses = LastFrameHits = LastFrameMisses = 0; }
+    IMGUI_API void  Clear();
+};
+
+// Free block of ImGuiDrawBuffersPool
+struct ImGuiDrawBuffersPoolBlock
+{
+    void*           Data;
+    int             Bytes;
+    int             FrameReleased;
+};
+
+// Memory shared by the vertex and index buffers of draw lists with UseBuffersPool set (windows draw lists, unless io.DrawBuffersPoolDecayFrames < 0).
+// Draw lists give their buffers back in Clear() and borrow a free block when PrimReserve() needs more room, so a spike in one window (e.g. a large popup shown for a frame) doesn't stay allocated by that window.
+// Free blocks are bucketed by size class (4 per power of two): a request is rounded up to a class size and served by the last block released in that class, which is at most 25% larger.
+// In NewFrame(), free blocks which haven't been borrowed for io.DrawBuffersPoolDecayFrames frames are released, as well as the oldest ones while there are more free bytes than the recent peak usage.
+struct ImGuiDrawBuffersPool
+{
+    ImVector<ImGuiDrawBuffersPoolBlock> FreeBlocks[128]; // FreeBlocks[n]: blocks of size class n, in release order, oldest first
+    int             FreeBlocksCount;
+    int             FreeBytes;
+    int             UsedBytes;          // Buffers of the pooled draw lists rendered during the last Render()
+    int             PeakUsedBytes;      // Highest UsedBytes over the last io.DrawBuffersPoolDecayFrames frames
+    int             PeakUsedFrame;
+    int             FrameCount;
+
+    ImGuiDrawBuffersPool() { FreeBlocksCount = FreeBytes = UsedBytes = PeakUsedBytes = 0; PeakUsedFrame = FrameCount = 0; }
+    IMGUI_API void* Acquire(int min_bytes, int* out_bytes);
+    IMGUI_API void  Release(void* data, int bytes);
+    IMGUI_API void  GarbageCollect(int frame_count, int decay_frames);
+    IMGUI_API void  Clear();
+};
+
+// Copy of the window state read by the per-frame sweeps over all windows (NewFrame(), FindHoveredWindow()), stored contiguously in ImGuiContext::WindowsHotData.
+// Those sweeps stream through this array and only touch the ImGuiWindow of the few windows which need work, instead of every large ImGuiWindow.
+// ImGuiWindow keeps its own fields for the rest of the code, the copy is refreshed in Begin() and wherever the sweeps modify them.
+struct ImGuiWindowHotData
+{
+    ImGuiWindow*        Window;                 // NULL for a free slot (destroyed window)
+    ImGuiWindowFlags    Flags;
+    bool                Active;
+    bool                WasActive;
+    bool                MemoryCompacted;
+    int                 LastFrameActive;
+    float               LastTimeActive;
+    int                 DisplayOrder;
+    ImRect              WindowRectClipped;
+};
+
+// Everything the size computations of Begin() (auto-fit, size constraints, scrollbars) depend on, compared with the previous frame's copy in ImGuiWindow::LayoutInputs.
+// When nothing changed the layout is stable: the size and scrollbars from last frame are reused and the size constraint callback isn't called again.
+struct ImGuiWindowLayoutInputs
+{
+    ImGuiSizeConstraintCallback SizeConstraintCallback;
+    void*               SizeConstraintCallbackUserData;
+    ImVec2              SizeContents;
+    ImVec2              SizeFull;               // Before auto-fit and constraints
+    ImVec2              WindowPadding;
+    ImVec2              WindowMinSize;
+    ImVec2              DisplaySize;            // Minus style.DisplaySafeAreaPadding
+    ImVec2              ItemSpacingScrollbarSize;
+    ImVec2              SizeConstraintPos;      // window->Pos passed to the size constraint callback, only set if there's a callback
+    ImRect              SizeConstraintRect;     // Only set if SetNextWindowSizeConstraints() was called
+    ImGuiWindowFlags    Flags;
+    int                 State;                  // ImGuiWindowLayoutState_ bits
+
+    ImGuiWindowLayoutInputs() { SizeConstraintCallback = NULL; SizeConstraintCallbackUserData = NULL; Flags = 0; State = 0; }
+};
+
+// Uniform grid over the display listing the active windows overlapping each cell, so hovered window queries only test the windows of one cell.
+// Windows are moved between cells from Begin() when their clipped rectangle changes, and removed when they stop being submitted.
+// Cells on the border of the grid extend to infinity so windows and positions outside of the display are handled.
+struct ImGuiWindowsHitGrid
+{
+    float           CellSize;
+    int             CellsX, CellsY;
+    ImVec2          DisplaySize;        // == io.DisplaySize when the grid was last rebuilt
+    ImVec2          TouchExtraPadding;  // == style.TouchExtraPadding when the grid was last rebuilt
+    ImVector<int>*  Cells;              // CellsX * CellsY lists of indices into ImGuiContext::WindowsHotData
+
+    ImGuiWindowsHitGrid()   { CellSize = 128.0f; CellsX = CellsY = 0; Cells = NULL; }
+    IMGUI_API void  Clear();
+    IMGUI_API void  AddWindow(ImGuiWindow* window, const ImRect& rect);
+    IMGUI_API void  RemoveWindow(ImGuiWindow* window);
+    int             GetCellX(float x) const { return ImClamp((int)(x / CellSize), 0, CellsX - 1); }   // Clamped, so border cells extend to infinity
+    int             GetCellY(float y) const { return ImClamp((int)(y / CellSize), 0, CellsY - 1); }
+};
+
+enum ImGuiInputEventType
+{
+    ImGuiInputEventType_MousePos,
+    ImGuiInputEventType_MouseButton,
+    ImGuiInputEventType_MouseWheel,
+    ImGuiInputEventType_Key,
+    ImGuiInputEventType_KeyMods,
+    ImGuiInputEventType_Char
+};
+
+// Input event queued by ImGuiIO::AddXXXEvent() and AddInputCharacter(), applied by NewFrame()
+struct ImGuiInputEvent
+{
+    ImGuiInputEventType Type;
+    double          Time;               // User timestamp in seconds, or -1.0
+    int             Index;              // Mouse button / key index / key modifiers (bit 0: Ctrl, 1: Shift, 2: Alt, 3: Super)
+    bool            Down;
+    ImVec2          Pos;
+    float           Wheel;
+    ImWchar         Char;
+};
+
 // Main state for ImGui
 struct ImGuiContext
 {
@@ -375,6 +599,10 @@ struct ImGuiContext
     int                     FrameCountRendered;
     ImVector<ImGuiWindow*>  Windows;
     ImVector<ImGuiWindow*>  WindowsSortBuffer;
+    ImGuiStorage            WindowsById;                        // Map ImGuiWindow::ID -> ImGuiWindow*, for FindWindowByName()
+    ImVector<ImGuiWindowHotData> WindowsHotData;                // Indexed by ImGuiWindow::HotDataIndex, slots are not moved so indices stay valid
+    ImVector<int>           WindowsHotDataFreeSlots;            // Slots of destroyed windows, reused by the next windows created
+    ImGuiWindowsHitGrid     WindowsHitGrid;                     // Spatial index of active windows for FindHoveredWindow()
     ImGuiWindow*            CurrentWindow;                      // Being drawn into
     ImVector<ImGuiWindow*>  CurrentWindowStack;
     ImGuiWindow*            FocusedWindow;                      // Will catch keyboard inputs
@@ -396,9 +624,16 @@ struct ImGuiContext
     float                   SettingsDirtyTimer;                 // Save .ini Settings on disk when time reaches zero
     ImVector<ImGuiColMod>   ColorModifiers;                     // Stack for PushStyleColor()/PopStyleColor()
     ImVector<ImGuiStyleMod> StyleModifiers;                     // Stack for PushStyleVar()/PopStyleVar()
+    ImVector<ImGuiStyleSnapshot> StyleSnapshotBackups;          // Stack for PushStyleSnapshot()/PopStyleSnapshot(), style and packed colors to restore
+    ImU32                   StyleColorsU32[ImGuiCol_COUNT];     // Style.Colors[] packed, GetColorU32() applies Style.Alpha to them
+    ImVec4                  StyleColorsU32Source[ImGuiCol_COUNT]; // Style.Colors[] that StyleColorsU32[] were computed from. GetColorU32() compares them with the style before using an entry, since the style may be modified in place at any time.
     ImVector<ImFont*>       FontStack;                          // Stack for PushFont()/PopFont()
     ImVector<ImGuiPopupRef> OpenPopupStack;                     // Which popups are open (persistent)
     ImVector<ImGuiPopupRef> CurrentPopupStack;                  // Which level of BeginPopup() we are in (reset every frame)
+    ImVector<ImGuiInputEvent> InputEventsQueue;                 // Events not applied yet
+    ImVector<ImWchar>       InputCharacters;                    // Characters input this frame, zero-terminated. io.InputCharacters[] only holds the first ones.
+    double                  InputMouseDownEventTime[5];         // Timestamp of the event which changed io.MouseDown[] this frame, or -1.0
+    double                  InputMouseClickedEventTime[5];      // Timestamp of the last click, or -1.0 if unknown. Used for double-click instead of io.MouseClickedTime[] when known.
 
     // Storage for SetNexWindow** and SetNextTreeNode*** functions
     ImVec2                  SetNextWindowPosVal;
@@ -420,10 +655,21 @@ struct ImGuiContext
     // Render
     ImDrawData              RenderDrawData;                     // Main ImDrawData instance to pass render information to the user
     ImVector<ImDrawList*>   RenderDrawLists[3];
+    ImVector<ImDrawVert>    RenderVtxArena;                     // Storage for ImDrawData arenas and offsets, if io.DrawDataUseArenas is set
+    ImVector<ImDrawIdx>     RenderIdxArena;
+    ImVector<int>           RenderVtxOffsets;
+    ImVector<int>           RenderIdxOffsets;
     float                   ModalWindowDarkeningRatio;
-    ImDrawList              OverlayDrawList;                    // Optional software render of mouse cursors, if io.MouseDrawCursor is set + a few debug overlays
+    ImDrawList              OverlayDrawList;                    // A few debug overlays, drawn over all windows
+    ImGuiDrawBuffersPool    DrawBuffersPool;                    // Vertex/index buffers of windows draw lists
     ImGuiMouseCursor        MouseCursor;
     ImGuiMouseCursorData    MouseCursorData[ImGuiMouseCursor_Count_];
+    ImDrawList              MouseCursorDrawList;                // Optional software render of mouse cursors, if io.MouseDrawCursor is set. Retained: only built again when the cursor shape or font texture changes, translated otherwise.
+    ImVector<ImVec2>        MouseCursorDrawListPos;             // Positions of MouseCursorDrawList vertices relative to the mouse position
+    ImGuiMouseCursor        MouseCursorDrawListCursor;          // Cursor shape and font texture MouseCursorDrawList was built for
+    ImTextureID             MouseCursorDrawListTexID;
+    int                     MouseCursorDrawListTexGeneration;
+    ImVec2                  MouseCursorDrawListMousePos;        // Mouse position MouseCursorDrawList vertices are currently translated to
 
     // Widget state
     ImGuiTextEditState      InputTextState;
@@ -437,8 +683,15 @@ struct ImGuiContext
     float                   DragSpeedScaleFast;
     ImVec2                  ScrollbarClickDeltaToGrabCenter;    // Distance between mouse and center of grab box, normalized in parent space. Use storage?
     char                    Tooltip[1024];
-    char*                   PrivateClipboard;                   // If no custom clipboard handler is defined
+    char*                   PrivateClipboard;                   // If no custom clipboard handler is defined (on Windows: last text read from the OS clipboard)
     ImVec2                  OsImePosRequest, OsImePosSet;       // Cursor position request & last passed to the OS Input Method Editor
+    ImGuiTextLayoutCache    TextLayoutCache;                    // Enabled with io.TextLayoutCacheSize > 0
+    ImGuiParsedFormat       FormatCache[64];                    // Display formats of scalar widgets, indexed by pointer
+    ImVector<ImGuiItemsIndex*> ItemsIndices;                     // Indices of zero-separated strings passed to Combo()
+    char                    TypeAheadBuf[32];                   // Text typed in the open Combo() popup (if io.ComboTypeAhead)
+    float                   TypeAheadTime;                      // Time of the last typed character
+    ImVector<ImGuiTable*>   Tables;                             // Persistent data for BeginTable()
+    ImGuiTable*             CurrentTable;
 
     // Logging
     bool                    LogEnabled;
@@ -465,6 +718,9 @@ struct ImGuiContext
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountRendered = -1;
+        memset(StyleColorsU32, 0, sizeof(StyleColorsU32));     // == Style colors packed from StyleColorsU32Source[], all (0,0,0,0)
+        for (int n = 0; n < IM_ARRAYSIZE(InputMouseDownEventTime); n++)
+            InputMouseDownEventTime[n] = InputMouseClickedEventTime[n] = -1.0;
         CurrentWindow = NULL;
         FocusedWindow = NULL;
         HoveredWindow = NULL;
@@ -508,11 +764,19 @@ struct ImGuiContext
         memset(Tooltip, 0, sizeof(Tooltip));
         PrivateClipboard = NULL;
         OsImePosRequest = OsImePosSet = ImVec2(-1.0f, -1.0f);
+        memset(TypeAheadBuf, 0, sizeof(TypeAheadBuf));
+        TypeAheadTime = 0.0f;
+        CurrentTable = NULL;
 
         ModalWindowDarkeningRatio = 0.0f;
         OverlayDrawList._OwnerName = "##Overlay"; // Give it a name for debugging
         MouseCursor = ImGuiMouseCursor_Arrow;
         memset(MouseCursorData, 0, sizeof(MouseCursorData));
+        MouseCursorDrawList._OwnerName = "##MouseCursor";
+        MouseCursorDrawListCursor = ImGuiMouseCursor_None;
+        MouseCursorDrawListTexID = NULL;
+        MouseCursorDrawListTexGeneration = 0;
+        MouseCursorDrawListMousePos = ImVec2(0.0f, 0.0f);
 
         LogEnabled = false;
         LogFile = NULL;
@@ -563,7 +827,7 @@ struct IMGUI_API ImGuiDrawContext
     ImVector<bool>          ButtonRepeatStack;
     ImVector<ImGuiGroupData>GroupStack;
     ImGuiColorEditMode      ColorEditMode;
-    int                     StackSizesBackup[6];    // Store size of various stacks for asserting
+    int                     StackSizesBackup[7];    // Store size of various stacks for asserting
 
     float                   IndentX;                // Indentation / start position from left of window (increased by TreePush/TreePop, etc.)
     float                   GroupOffsetX;
@@ -655,7 +919,17 @@ struct IMGUI_API ImGuiWindow
     ImVector<ImGuiID>       IDStack;                            // ID stack. ID are hashes seeded with the value at the top of the stack
     ImRect                  ClipRect;                           // = DrawList->clip_rect_stack.back(). Scissoring / clipping rectangle. x1, y1, x2, y2.
     ImRect                  WindowRectClipped;                  // = WindowRect just after setup in Begin(). == window->Rect() for root window.
+    int                     HotDataIndex;                       // Index of the copy of the frequently swept state in g.WindowsHotData
+    ImRect                  HitGridCells;                       // Range of cells (inclusive) where the window is registered in g.WindowsHitGrid. Max < Min when not registered.
+    int                     DisplayOrder;                       // Index in g.Windows after the sort at the end of the frame, higher is in front. Used to pick the front-most window in g.WindowsHitGrid.
     int                     LastFrameActive;
+    float                   LastTimeActive;                     // Value of g.Time on last Begin(), to release memory of windows that are not submitted anymore (see io.WindowsCompactTimer)
+    bool                    MemoryCompacted;                    // Set when draw buffers and temporary stacks have been released, they are reallocated on next Begin()
+    ImGuiWindowLayoutInputs LayoutInputs;                       // Inputs of last frame's size computations in Begin()
+    ImVec2                  LayoutSizeFull;                     // Results of last frame's size computations, reused while the layout is stable
+    ImVec2                  LayoutSizeAutoFit;
+    ImVec2                  LayoutScrollbarsSize;               // Size the scrollbars were last evaluated with
+    int                     LayoutStableFrames;                 // Number of consecutive frames the inputs of the size computations didn't change
     float                   ItemWidthDefault;
     ImGuiSimpleColumns      MenuColumns;                        // Simplified columns storage for menu items
     ImGuiStorage            StateStorage;
@@ -761,6 +1035,8 @@ namespace ImGui
     IMGUI_API void          PlotEx(ImGuiPlotType plot_type, const char* label, float (*values_getter)(void* data, int idx), void* data, int values_count, int values_offset, const char* overlay_text, float scale_min, float scale_max, ImVec2 graph_size);
 
     IMGUI_API int           ParseFormatPrecision(const char* fmt, int default_value);
+    IMGUI_API int           FormatScalar(char* buf, int buf_size, const char* fmt, float v);    // Same as ImFormatString(buf, buf_size, fmt, v). "%f", "%.Nf" and "%g" with literal text around don't go through vsnprintf
+    IMGUI_API int           FormatScalar(char* buf, int buf_size, const char* fmt, int v);      // Same as ImFormatString(buf, buf_size, fmt, v). "%d" with literal text around doesn't go through vsnprintf
     IMGUI_API float         RoundScalar(float value, int decimal_precision);
 
 } // namespace ImGui